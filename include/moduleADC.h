@@ -16,10 +16,20 @@
 #define MODULEADC_H
 
 #include "lpc17xx_adc.h"
+#include "lpc17xx_clkpwr.h"
+#include "lpc17xx_gpdma.h"
 #include "lpc17xx_nvic.h"
 #include "lpc17xx_timer.h"
 #include "moduleDAC.h"
+#include "moduleDMA.h"
+#include "moduleDistance.h"
+#include "moduleEvent.h"
+#include "moduleRing.h"
+#include "moduleSignal.h"
 #include "moduleSystick.h"
+#include "moduleTime.h"
+#include "moduleTracker.h"
+#include "moduleZone.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -28,7 +38,7 @@
  * @brief Configuring and managing the ADC for the system.
  *
  * This module configures the ADC (Analog-Digital Converter) and its interaction with a timer
- * to perform periodic readings.
+ * to perform periodic readings, or with the GPDMA to acquire whole blocks of conversions.
  */
 
 /**
@@ -36,36 +46,233 @@
  * @brief Constants and definitions related to ADC configuration.
  *
  */
-#define SECOND            10000  ///< Number of cycles for one second in the timer.
-#define ADC_FREQ          100000 ///< ADC sampling rate in Hz.
-#define MAX_VALUE_ALLOWED 2048   ///< Maximum value allowed in the ADC for system logic.
-#define NUM_SAMPLES       4      ///< Number of samples used in the table.
+#define SECOND   10000  ///< Number of cycles for one second in the timer.
+#define ADC_FREQ 100000 ///< ADC sampling rate in Hz.
 
-/// Last value read from ADC.
+/**
+ * @defgroup ADC acquisition modes
+ * @brief Ways of moving conversions from the ADC to the system logic.
+ *
+ */
+#define ADC_MODE_TIMER_IRQ  0 ///< TIMER0 ISR starts every conversion and the ADC ISR reads it.
+#define ADC_MODE_DMA_BLOCK  1 ///< Burst conversions moved by GPDMA into two alternating sample blocks.
+#define ADC_MODE_MATCH_EDGE 2 ///< Conversions started in hardware by the MAT0.1 edge, no TIMER0 ISR.
+#define ADC_MODE_SCAN       3 ///< Burst scan of every channel in ADC_SCAN_CHANNELS, one ISR per scan.
+#define ADC_MODE_COUNT      4 ///< Number of acquisition modes.
+
+#ifndef ADC_DEFAULT_MODE
+#define ADC_DEFAULT_MODE ADC_MODE_DMA_BLOCK ///< Acquisition mode started by main().
+#endif
+
+#define ADC_BLOCK_SIZE  128 ///< Conversions per DMA block, the CPU wakes once per block.
+#define ADC_RING_SIZE   512 ///< Filtered samples kept for the consumers, a power of two, see below.
+#define ADC_RAW_RING    32  ///< Raw conversions queued between the ADC ISR and PendSV, a power of two.
+
+/**
+ * @brief Select the ADC interrupt handler of the per-sample and scan modes.
+ *
+ * 0: minimal handler, reads each data register once, queues the conversions and defers the processing to
+ * PendSV. 1: previous handler, masks its own NVIC line and runs the whole chain inside the interrupt.
+ * Both are instrumented the same way (`adc_isr_stats`, `adc_latency_stats`) so they can be compared.
+ */
+#ifndef ADC_ISR_LEGACY
+#define ADC_ISR_LEGACY 0
+#endif
+
+#define ADC_MATCH_SAMPLE_RATE 1000 ///< Sample rate in Hz of the MAT0.1 triggered mode.
+#define ADC_MATCH_CHANNEL     1    ///< TIMER0 match channel routed to the ADC start logic (MAT0.1).
+
+#define ADC_MAX_CHANNELS    8    ///< Channels of the AD0 converter.
+#define ADC_SCAN_CONV_RATE  8000 ///< Conversions per second in scan mode, shared by all scanned channels.
+#define ADC_SCAN_FILTER_LOG 2    ///< Per-channel smoothing: filtered += (value - filtered) >> ADC_SCAN_FILTER_LOG.
+
+/**
+ * @defgroup ADC decimation ratios
+ * @brief Default oversampling of each mode, as log2 of the number of conversions averaged per value.
+ *
+ */
+#define ADC_TIMER_DECIM_LOG 0 ///< 1 Hz conversions are already slow, every one is used.
+#define ADC_DMA_DECIM_LOG   5 ///< 100 kHz / 32: about 3.1 kHz, four values per DMA block.
+#define ADC_MATCH_DECIM_LOG 2 ///< 1 kHz / 4: 250 Hz.
+#define ADC_SCAN_DECIM_LOG  0 ///< The scan engine smooths each channel on its own (ADC_SCAN_FILTER_LOG).
+
+/**
+ * @brief Set of AD0 channels scanned in `ADC_MODE_SCAN`, one bit per channel.
+ *
+ * Channel 0 (P0.23) is the sensor used by the single-channel modes and must always be part of the set.
+ * Channels 3 (P0.26), 6 (P0.3) and 7 (P0.2) share their pins with the DAC and UART0 on this board.
+ */
+#ifndef ADC_SCAN_CHANNELS
+#define ADC_SCAN_CHANNELS 0x01 ///< Only AD0.0 by default, e.g. 0x37 for AD0.0-AD0.2, AD0.4 and AD0.5.
+#endif
+
+#if (ADC_RING_SIZE & (ADC_RING_SIZE - 1)) != 0 || (ADC_RAW_RING & (ADC_RAW_RING - 1)) != 0
+#error "ADC_RING_SIZE and ADC_RAW_RING must be powers of two"
+#endif
+
+/*
+ * adc_ring holds at least one SysTick period of the fastest default mode, a scan of a single channel with
+ * every round kept (ADC_SCAN_CONV_RATE, 400 values per period), so a consumer that is late by a whole
+ * period loses nothing. Telemetry does not wait for the period: the producer wakes it as soon as a batch
+ * is waiting, see continue_reverse.
+ */
+#if ADC_RING_SIZE * 1000 < ADC_SCAN_CONV_RATE * SYSTICK_TIME
+#error "ADC_RING_SIZE must hold one SysTick period of conversions at ADC_SCAN_CONV_RATE"
+#endif
+#if ADC_RAW_RING <= ADC_MAX_CHANNELS
+#error "ADC_RAW_RING must hold a whole scan round"
+#endif
+
+#if !(ADC_SCAN_CHANNELS & 0x01)
+#error "ADC_SCAN_CHANNELS must include AD0.0, the sensor of the single-channel modes"
+#endif
+#if (ADC_SCAN_CHANNELS & 0xC8)
+#error "ADC_SCAN_CHANNELS includes AD0.3, AD0.6 or AD0.7, whose pins are used by the DAC and UART0"
+#endif
+
+/**
+ * @brief Per-channel state of the scan engine, as a structure of arrays.
+ *
+ * Slot `i` describes AD0 channel `channel[i]`. Each field is a contiguous array, so the ISR writes every
+ * value of a scan into consecutive memory and consumers walking one field never touch the others.
+ */
+typedef struct
+{
+    uint8_t count;                       ///< Number of scanned channels (used slots).
+    uint8_t channel[ADC_MAX_CHANNELS];   ///< AD0 channel number of each slot.
+    uint16_t value[ADC_MAX_CHANNELS];    ///< Latest raw 12-bit conversion of each slot.
+    uint16_t filtered[ADC_MAX_CHANNELS]; ///< Smoothed value of each slot.
+    uint16_t distance[ADC_MAX_CHANNELS]; ///< Distance of each slot in millimetres, from the smoothed value.
+    uint8_t zone[ADC_MAX_CHANNELS];      ///< Proximity zone of each slot (ZONE_*).
+    uint32_t scans;                      ///< Number of completed scans.
+} adc_scan_t;
+
+/// Last filtered value, the one the system logic acts on.
 extern volatile uint32_t adc_read_value;
 
+/// Last raw conversion, before the decimation filter.
+extern volatile uint32_t adc_raw_value;
+
+/// Distance to the obstacle in millimetres, from `adc_read_value`.
+extern volatile uint16_t distance_mm;
+
+/// Closing speed and time to collision estimated from `distance_mm`.
+extern tracker_t adc_tracker;
+
+/// Every filtered sample with its timestamp, distance and zone, for a single consumer.
+extern sample_ring_t adc_ring;
+
+/// Raw conversions of the per-sample and scan modes, from the ADC ISR to the PendSV pipeline.
+extern sample_ring_t adc_raw_ring;
+
+/// CPU cycles spent in each ADC interrupt.
+extern cycle_stats_t adc_isr_stats;
+
+/// CPU cycles from the conversion start to the ADC interrupt entry (conversion time plus latency).
+extern cycle_stats_t adc_latency_stats;
+
+/// CPU cycles spent per sample by the PendSV pipeline (filter, distance, zone, tracker).
+extern cycle_stats_t adc_pipeline_stats;
+
+/// Decimation ratio of each acquisition mode, as log2; applied when the mode is started.
+extern uint8_t adc_decimation_log2[ADC_MODE_COUNT];
+
+/// Acquisition mode currently running (one of the ADC_MODE_* values).
+extern volatile uint8_t adc_acquisition_mode;
+
+/// Ping-pong sample blocks written by the GPDMA, raw ADGDR words.
+extern volatile uint32_t adc_dma_block[2][ADC_BLOCK_SIZE];
+
+/// Number of GPDMA error interrupts seen on the ADC channel.
+extern volatile uint32_t adc_dma_errors;
+
+/// State of every scanned channel.
+extern volatile adc_scan_t adc_scan;
+
+/// Period between consecutive conversion starts, in CPU cycles, for each per-sample acquisition mode.
+extern cycle_stats_t adc_period_stats[ADC_MODE_COUNT];
+
 /**
  * @brief Set the timer and matching system for the ADC.
  *
- * Initializes the timer that controls the ADC sample rate.
+ * Initializes the timer that controls the ADC sample rate, either interrupting the CPU on every match
+ * (`ADC_MODE_TIMER_IRQ`) or toggling the MAT0.1 output that starts the conversions in hardware
+ * (`ADC_MODE_MATCH_EDGE`).
+ *
+ * @param mode Acquisition mode the timer is configured for.
  */
-void configure_timer_and_match(void);
+void configure_timer_and_match(uint8_t mode);
 
 /**
  * @brief Start ADC timer.
  *
- * Activates the timer that generates the signals for the ADC conversions.
+ * Activates the timer that generates the signals for the ADC conversions. Its interrupt is only enabled
+ * when the timer drives the conversions from software.
+ *
+ * @param mode Acquisition mode the timer was configured for.
  */
-void start_timer(void);
+void start_timer(uint8_t mode);
 
 /**
  * @brief Configure the system ADC.
  *
  * Initializes the ADC with the settings necessary to convert on a specific channel.
+ * Conversions are not started until @ref adc_start_acquisition is called.
  *
  */
 void configure_adc(void);
 
+/**
+ * @brief Start acquiring samples in the given mode.
+ *
+ * Stops whatever acquisition is running and restarts the ADC in the requested mode.
+ *
+ * @param mode One of the ADC_MODE_* values.
+ */
+void adc_start_acquisition(uint8_t mode);
+
+/**
+ * @brief Stop the running acquisition.
+ *
+ * Disables the timer, burst conversions, the ADC DMA channel and the ADC interrupt.
+ */
+void adc_stop_acquisition(void);
+
+/**
+ * @brief Configure the ADC to scan every channel in `ADC_SCAN_CHANNELS` in burst mode.
+ *
+ * Fills the channel list of @ref adc_scan and enables the interrupt of the highest selected channel only,
+ * which is the last one converted in each round.
+ */
+void configure_adc_scan(void);
+
+/**
+ * @brief Read the result of a complete scan.
+ *
+ * Reads the data register of every scanned channel in a single pass and feeds each one to
+ * @ref adc_scan_process. Only the legacy handler (`ADC_ISR_LEGACY`) calls it, from the interrupt.
+ */
+void adc_scan_read(void);
+
+/**
+ * @brief Feed the conversion of one scanned channel to its slot.
+ *
+ * Updates the smoothed value, distance and zone of the slot. The last slot of the round publishes the
+ * nearest obstacle (lowest value) in `adc_read_value` and runs @ref continue_reverse.
+ *
+ * @param slot  Slot of the channel in @ref adc_scan, below `adc_scan.count`.
+ * @param value Raw 12-bit conversion.
+ */
+void adc_scan_process(uint8_t slot, uint16_t value);
+
+/**
+ * @brief Configure the GPDMA to move conversions into the ping-pong blocks.
+ *
+ * Two linked list items point to each other, so the channel alternates between both blocks forever and
+ * raises a terminal count interrupt every time one of them is full.
+ */
+void configure_adc_dma(void);
+
 /**
  * @brief Timer interrupt handler (TIMER0).
  *
@@ -76,14 +283,91 @@ void TIMER0_IRQHandler(void);
 /**
  * @brief ADC Interrupt Handler.
  *
- * Processes the data converted by the ADC and updates the system status.
+ * Reads the conversion, or in scan mode every channel of the round, queues it in `adc_raw_ring` and raises
+ * `EVENT_ADC_SAMPLES`.
  */
 void ADC_IRQHandler(void);
 
+/**
+ * @brief PendSV side of the per-sample and scan modes.
+ *
+ * Drains `adc_raw_ring` and runs every conversion through @ref adc_process_sample, or in scan mode through
+ * @ref adc_scan_process.
+ *
+ * @param events Raised events (EVENT_ADC_SAMPLES).
+ */
+void adc_on_samples(uint32_t events);
+
+/**
+ * @brief GPDMA callback of the ADC channel, called from `DMA_IRQHandler`.
+ *
+ * Runs once per finished ADC block and hands the block to @ref adc_process_block.
+ *
+ * @param channel Channel that interrupted.
+ * @param status  `DMA_STATUS_DONE` and/or `DMA_STATUS_ERROR`.
+ */
+void adc_on_dma(uint8_t channel, uint32_t status);
+
+/**
+ * @brief Process one block of raw conversions.
+ *
+ * Runs the block through the decimation filter and, for every value it produces, publishes it in
+ * `adc_read_value` and updates the system status.
+ *
+ * @param block Raw ADGDR words.
+ * @param count Number of words in the block.
+ */
+void adc_process_block(const volatile uint32_t* block, size_t count);
+
+/**
+ * @brief Record the instant a conversion was started.
+ *
+ * Accumulates the time elapsed since the previous start in the period statistics of the running mode,
+ * so the sample-period jitter of the software and the hardware triggered modes can be compared.
+ *
+ * @param cycles Cycle counter value at the conversion start.
+ */
+void adc_record_sample_start(uint32_t cycles);
+
+/**
+ * @brief Feed one conversion of the per-sample modes to the decimation filter.
+ *
+ * Publishes the raw value in `adc_raw_value` and, once a window is complete, the filtered one in
+ * `adc_read_value`, updating the system status.
+ *
+ * @param value 12-bit conversion result.
+ */
+void adc_process_sample(uint16_t value);
+
+/**
+ * @brief Rate at which the running mode delivers filtered values.
+ *
+ * @param mode Acquisition mode (one of the ADC_MODE_* values).
+ * @return Filtered values per second, after decimation.
+ */
+uint32_t adc_output_rate(uint8_t mode);
+
+/**
+ * @brief Change the filtered sample rate of the running mode.
+ *
+ * The conversion rate of each mode is fixed, the rate is set with its decimation ratio, a power of two,
+ * and restarts the acquisition.
+ *
+ * @param rate Filtered values per second wanted.
+ * @return Filtered values per second obtained, the lowest rate of the mode not below `rate` (or its
+ *         conversion rate when that is below `rate`).
+ */
+uint32_t adc_set_output_rate(uint32_t rate);
+
 /**
  * @brief System status management based on ADC value continues.
  *
- * Determines whether the system should operate in normal or reverse mode based on the ADC value read.
+ * Converts the filtered ADC value into `distance_mm`, classifies it into `proximity_zone`, with the
+ * hysteresis of the zone table, and feeds the tracker. `alarm_level` is the nearest of the zone and the
+ * level demanded by the time to collision, so a fast approach escalates the alarm before the distance does.
+ * `EVENT_ZONE_CHANGE` is raised only when one of them changes; the consumers do no work in between.
+ * Every sample is also pushed into `adc_ring`, so a consumer sees all of them and always with the zone
+ * that was computed from them. `EVENT_TELEMETRY` is raised whenever the ring holds a whole telemetry batch.
  *
  */
 void continue_reverse(void);
@@ -0,0 +1,158 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleBatch.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_BATCH_H
+#define MODULE_BATCH_H
+
+#include "moduleCodec.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleBatch.h
+ * @brief Hardware-independent aggregation of filtered samples into time stamped frames.
+ *
+ * Samples are collected with their timestamp and their zone and alarm level; a frame carries a run of
+ * them so the receiver can rebuild when each one was taken. Payload layout, little endian:
+ *
+ * | Bytes | Field                                                                                    |
+ * |-------|------------------------------------------------------------------------------------------|
+ * | 4     | Base timestamp, microseconds: timestamp of the first sample.                             |
+ * | 1     | Flags, as in the snapshot (PROTOCOL_FLAG_*).                                             |
+ * | 4     | Samples dropped by the ADC ring so far.                                                  |
+ * | 4     | Bytes dropped by the UART transmit ring so far.                                          |
+ * | 1     | Offset unit, as a power of two of microseconds.                                          |
+ * | 1     | Zone and alarm level of the first sample (@ref BATCH_STATE).                             |
+ * | 1     | Number of changes, followed by one (sample index, new state) pair per change.            |
+ * | ...   | Values, one moduleCodec block.                                                           |
+ * | ...   | Intervals between consecutive offsets, in offset units, one moduleCodec block (first 0). |
+ *
+ * A steady sampling period gives equal intervals, whose differences take half a byte in the codec, so
+ * the timing costs about as much as the values.
+ */
+
+/**
+ * @defgroup Batch constants
+ * @brief Frame limits.
+ *
+ */
+#define BATCH_MAX_SAMPLES  64 ///< Samples kept by a batch, and in one frame.
+#define BATCH_HEADER_SIZE  16 ///< Fixed part of a payload, up to the number of changes included.
+#define BATCH_MIN_PAYLOAD  32 ///< Smallest payload room @ref batch_pack accepts; a single sample always fits.
+#define BATCH_STATE_SHIFT  4  ///< Alarm level position in a state byte.
+
+/**
+ * @brief Zone and alarm level packed into one state byte.
+ */
+#define BATCH_STATE(zone, level) ((uint8_t)(((zone) & 0x0F) | ((level) << BATCH_STATE_SHIFT)))
+
+/**
+ * @brief Samples collected for the next frames.
+ *
+ * Structure of arrays, like the ADC scan state: the encoder walks each field on its own.
+ */
+typedef struct
+{
+    uint32_t times[BATCH_MAX_SAMPLES];  ///< Microsecond timestamp of each sample.
+    uint16_t values[BATCH_MAX_SAMPLES]; ///< Filtered value of each sample.
+    uint8_t states[BATCH_MAX_SAMPLES];  ///< @ref BATCH_STATE of each sample.
+    uint8_t count;                      ///< Samples collected.
+    uint8_t size;                       ///< Samples that make a full batch.
+} batch_t;
+
+/**
+ * @brief Counters sent with every frame.
+ */
+typedef struct
+{
+    uint8_t flags;         ///< PROTOCOL_FLAG_* and acquisition mode.
+    uint32_t adc_overruns; ///< Samples dropped by the ADC ring.
+    uint32_t uart_dropped; ///< Bytes dropped by the UART transmit ring.
+} batch_counters_t;
+
+/**
+ * @brief A decoded frame.
+ */
+typedef struct
+{
+    uint32_t base;                       ///< Timestamp of the first sample, in microseconds.
+    batch_counters_t counters;           ///< Counters at the time of the frame.
+    uint8_t count;                       ///< Samples in the frame.
+    uint8_t changes;                     ///< Zone or alarm level changes inside the frame.
+    uint32_t offsets[BATCH_MAX_SAMPLES]; ///< Time of each sample after `base`, in microseconds.
+    uint16_t values[BATCH_MAX_SAMPLES];  ///< Value of each sample.
+    uint8_t states[BATCH_MAX_SAMPLES];   ///< @ref BATCH_STATE of each sample.
+} batch_frame_t;
+
+/**
+ * @brief Empty a batch and set its size.
+ *
+ * @param batch Batch to initialize.
+ * @param size  Samples that make a full batch, clamped to 1..`BATCH_MAX_SAMPLES`.
+ */
+void batch_init(batch_t* batch, uint8_t size);
+
+/**
+ * @brief Change the size of a batch, keeping its samples.
+ *
+ * @param batch Batch to update.
+ * @param size  Samples that make a full batch, clamped to 1..`BATCH_MAX_SAMPLES`.
+ */
+void batch_resize(batch_t* batch, uint8_t size);
+
+/**
+ * @brief Add a sample.
+ *
+ * @param batch     Batch to update.
+ * @param timestamp Microsecond timestamp of the sample.
+ * @param value     Filtered value.
+ * @param state     @ref BATCH_STATE of the sample.
+ * @return 1 if the batch is now full, 0 if there is room left, -1 if the sample was dropped (no room).
+ */
+int batch_add(batch_t* batch, uint32_t timestamp, uint16_t value, uint8_t state);
+
+/**
+ * @brief Time since the first sample of a batch.
+ *
+ * @param batch Batch to query.
+ * @param now   Current microsecond timestamp.
+ * @return Age in microseconds, 0 for an empty batch.
+ */
+uint32_t batch_age(const batch_t* batch, uint32_t now);
+
+/**
+ * @brief Encode the oldest samples of a batch into a frame payload and remove them.
+ *
+ * As many samples as fit in `room` are taken, so a frame never overflows; the others stay for the next
+ * frame.
+ *
+ * @param batch    Batch to drain.
+ * @param counters Counters to send.
+ * @param out      Destination, `room` bytes.
+ * @param room     Payload room, at least `BATCH_MIN_PAYLOAD`.
+ * @return Payload length, 0 if the batch is empty.
+ */
+size_t batch_pack(batch_t* batch, const batch_counters_t* counters, uint8_t* out, size_t room);
+
+/**
+ * @brief Decode a frame payload.
+ *
+ * @param payload Payload bytes.
+ * @param length  Payload length.
+ * @param frame   Destination.
+ * @return 0 on success, -1 if the payload is not a valid frame.
+ */
+int batch_unpack(const uint8_t* payload, size_t length, batch_frame_t* frame);
+
+#endif // MODULE_BATCH_H
@@ -0,0 +1,86 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleBaud.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_BAUD_H
+#define MODULE_BAUD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleBaud.h
+ * @brief Hardware-independent UART baud rate divider calculation.
+ *
+ * The LPC17xx UART divides its peripheral clock by 16, by the 16-bit divisor DLM:DLL and by the fractional
+ * divider `1 + DIVADDVAL / MULVAL`:
+ *
+ *     baud = PCLK / (16 * DL * (1 + DIVADDVAL / MULVAL))
+ *
+ * Every fraction is tried and the closest rate kept. The user manual requires DL >= 3 whenever DIVADDVAL is
+ * not zero, which the CMSIS driver does not enforce; this module does, so high rates need a fast PCLK.
+ */
+
+/**
+ * @defgroup Baud constants
+ * @brief Accuracy limit and standard rates.
+ *
+ */
+#define BAUD_MAX_ERROR_PPM     15000 ///< Largest accepted rate error (1.5 %), leaves margin for the other end.
+#define BAUD_MIN_FRACTIONAL_DL 3     ///< Smallest divisor allowed with the fractional divider in use.
+
+/**
+ * @brief Rates the host can ask for, in ascending order.
+ */
+#define BAUD_STANDARD_RATES {9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600}
+#define BAUD_STANDARD_COUNT 8 ///< Number of entries of `BAUD_STANDARD_RATES`.
+
+/**
+ * @brief Divider settings of one rate.
+ */
+typedef struct
+{
+    uint16_t divisor;  ///< DLM:DLL.
+    uint8_t mulval;    ///< FDR MULVAL, 1 to 15.
+    uint8_t divaddval; ///< FDR DIVADDVAL, 0 to MULVAL - 1.
+    uint32_t actual;   ///< Rate produced by these settings.
+    int32_t error_ppm; ///< Relative error of `actual`, in parts per million.
+} baud_divider_t;
+
+/**
+ * @brief Find the divider settings closest to a rate.
+ *
+ * @param pclk    UART peripheral clock, in Hz.
+ * @param baud    Requested rate.
+ * @param divider Receives the closest settings found, even when the error is too large.
+ * @return 0 if the error is within `BAUD_MAX_ERROR_PPM`, -1 otherwise or if no divisor fits.
+ */
+int baud_divider(uint32_t pclk, uint32_t baud, baud_divider_t* divider);
+
+/**
+ * @brief Standard rate closest to a measured one.
+ *
+ * @param measured Rate measured by auto-baud.
+ * @return Entry of `BAUD_STANDARD_RATES` with the smallest relative distance.
+ */
+uint32_t baud_snap(uint32_t measured);
+
+/**
+ * @brief Whether a rate is one of `BAUD_STANDARD_RATES`.
+ *
+ * @param baud Rate to check.
+ * @return 1 if it is, 0 otherwise.
+ */
+int baud_is_standard(uint32_t baud);
+
+#endif // MODULE_BAUD_H
@@ -0,0 +1,113 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleBuzzer.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_BUZZER_H
+#define MODULE_BUZZER_H
+
+#include "lpc17xx_pwm.h"
+#include "lpc17xx_timer.h"
+#include "moduleCadence.h"
+#include "moduleDAC.h"
+#include "moduleEINT.h"
+#include "moduleZone.h"
+#include <stdint.h>
+
+/**
+ * @file moduleBuzzer.h
+ * @brief Alarm tone and beep cadence, on top of a build-time selected backend.
+ *
+ * The rest of the system only asks for the tone of an alarm level and this module gates it on and off
+ * with the cadence of the current distance (TIMER1). The tone itself comes from one of two backends:
+ * - `BUZZER_BACKEND_DAC`: the wavetables of moduleDAC, streamed to the DAC by the GPDMA (speaker).
+ * - `BUZZER_BACKEND_PWM`: a 50% square wave on PWM1.1 (P2.0), no DMA channel and no bus traffic at all
+ *   (piezo buzzer). The frequencies are taken from `dac_zone_wave`, so both backends sound the same.
+ *
+ * With the DAC backend and the ADC scanning several sensors, the single gated tone is replaced by the
+ * mixer of moduleDAC: one voice per sensor, each with the tone of its own zone (slightly higher for every
+ * slot, so sides can be told apart) and the cadence of its own distance.
+ */
+
+/**
+ * @defgroup Buzzer backends
+ * @brief Values of `BUZZER_BACKEND`.
+ *
+ */
+#define BUZZER_BACKEND_DAC 0 ///< DAC fed by the GPDMA.
+#define BUZZER_BACKEND_PWM 1 ///< PWM1 output, no CPU or DMA per period.
+
+#ifndef BUZZER_BACKEND
+#define BUZZER_BACKEND BUZZER_BACKEND_DAC ///< Backend compiled in, select with -DBUZZER_BACKEND=...
+#endif
+
+/**
+ * @defgroup Buzzer configuration
+ * @brief Timers and outputs of the buzzer.
+ *
+ */
+#define CADENCE_TIMER      LPC_TIM1              ///< Timer gating the tone on and off.
+#define BUZZER_PWM_CHANNEL 1                     ///< PWM1.1, on P2.0 (function 1).
+#define BUZZER_VOICE_GAIN  (MIXER_GAIN_FULL / 2) ///< Amplitude of each sensor's voice when mixing.
+#define BUZZER_VOICE_STEP  8                     ///< Sensor i sounds (8 + i) / 8 times its zone's tone.
+
+/**
+ * @brief Start the selected backend and the beep cadence.
+ *
+ * The DMA service must be configured before, the DAC backend reserves a channel. The tone starts on.
+ */
+void configure_buzzer(void);
+
+/**
+ * @brief Tone frequency of an alarm level.
+ *
+ * @param level Alarm level (ZONE_*).
+ * @return Frequency in Hz, 0 for the silent level.
+ */
+uint32_t buzzer_frequency(uint8_t level);
+
+/**
+ * @brief Updates the tone to the current alarm level.
+ *
+ * It is played right away if the cadence is in a beep, otherwise when the next beep starts.
+ */
+void update_buzzer(void);
+
+/**
+ * @brief Enable or mute the buzzer.
+ *
+ * @param state ENABLE to restart the cadence, DISABLE to stop it and fade the tone out.
+ */
+void buzzer_enable(FunctionalState state);
+
+/**
+ * @brief Enable change consumer of the buzzer, follows `habilitar`.
+ *
+ * @param events Raised events (EVENT_ENABLE).
+ */
+void buzzer_on_enable(uint32_t events);
+
+/**
+ * @brief Zone change consumer of the buzzer.
+ *
+ * @param events Raised events (EVENT_ZONE_CHANGE).
+ */
+void buzzer_on_zone_change(uint32_t events);
+
+/**
+ * @brief Cadence timer interrupt handler (TIMER1).
+ *
+ * Ends a beep or a silence and programs the length of the next one from the current distance.
+ */
+void TIMER1_IRQHandler(void);
+
+#endif // MODULE_BUZZER_H
@@ -0,0 +1,60 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleCadence.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_CADENCE_H
+#define MODULE_CADENCE_H
+
+#include <stdint.h>
+
+/**
+ * @file moduleCadence.h
+ * @brief Hardware-independent beep cadence as a function of the distance.
+ *
+ * Every beep lasts `CADENCE_ON_MS`; the silence after it shrinks linearly with the distance, from
+ * `CADENCE_OFF_MAX_MS` at `CADENCE_FAR_MM` down to nothing at `CADENCE_SOLID_MM`, where the beeps merge
+ * into a solid tone. The result is in microseconds, so a timer match can follow every millimetre. A silence
+ * is never shorter than `CADENCE_OFF_MIN_MS`, which also leaves a timer interrupt time to program it.
+ */
+
+/**
+ * @defgroup Cadence constants
+ * @brief Shape of the cadence curve.
+ *
+ */
+#ifndef CADENCE_SOLID_MM
+#define CADENCE_SOLID_MM 300 ///< Solid tone at or below this distance.
+#endif
+#define CADENCE_FAR_MM     2000 ///< Slowest cadence at or beyond this distance, the exit level of caution.
+#define CADENCE_ON_MS      80   ///< Length of every beep.
+#define CADENCE_OFF_MAX_MS 900  ///< Silence between beeps at `CADENCE_FAR_MM`.
+#define CADENCE_OFF_MIN_MS 10   ///< Shorter silences are not audible (a few tone periods) and become solid.
+
+/**
+ * @brief One beep and the silence after it.
+ */
+typedef struct
+{
+    uint32_t on_us;  ///< Tone time, in microseconds.
+    uint32_t off_us; ///< Silence time, in microseconds; 0 for a solid tone.
+} cadence_t;
+
+/**
+ * @brief Beep cadence for a distance.
+ *
+ * @param distance_mm Distance to the obstacle.
+ * @param cadence     Receives the tone and silence times.
+ */
+void cadence_from_distance(uint16_t distance_mm, cadence_t* cadence);
+
+#endif // MODULE_CADENCE_H
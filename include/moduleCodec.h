@@ -0,0 +1,106 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleCodec.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_CODEC_H
+#define MODULE_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleCodec.h
+ * @brief Hardware-independent compression of sample blocks.
+ *
+ * A block is its sample count and first sample, as unsigned LEB128 varints, followed by the differences
+ * between consecutive samples. Each difference is taken modulo 2^16 and zigzag mapped (0, -1, 1, -2...
+ * become 0, 1, 2, 3...), so small changes of either sign give small codes. The codes are grouped in runs,
+ * each introduced by a control byte:
+ *
+ * | Control byte | Run                                                                            |
+ * |--------------|--------------------------------------------------------------------------------|
+ * | `0nnnnnnn`   | `n + 1` codes below 16, two per byte, low nibble first; a last odd nibble is 0. |
+ * | `1nnnnnnn`   | `n + 1` codes as varints, one to three bytes each.                             |
+ *
+ * A slowly changing 12-bit signal takes about half a byte per sample instead of two, or four to five as
+ * decimal text. The decoder is a byte at a time state machine, so it can sit right behind a receiver.
+ */
+
+/**
+ * @defgroup Codec constants
+ * @brief Run limits.
+ *
+ */
+#define CODEC_RUN_MAX    128 ///< Codes in one run, 7 bits of the control byte.
+#define CODEC_NIBBLE_MAX 15  ///< Largest code of a nibble run.
+#define CODEC_NIBBLE_MIN 4   ///< Shortest nibble run worth a control byte of its own.
+#define CODEC_VARINT_MAX 3   ///< Bytes of the longest varint, for a 16-bit value.
+
+/**
+ * @brief Largest encoded size of a block of `count` samples: every difference as a three-byte varint.
+ */
+#define CODEC_BLOCK_MAX(count) (2 * CODEC_VARINT_MAX + CODEC_VARINT_MAX * (count) + (count) / CODEC_RUN_MAX + 1)
+
+/**
+ * @brief Stream decoder state.
+ */
+typedef struct
+{
+    uint8_t state;      ///< Field being decoded.
+    uint8_t shift;      ///< Bits of the varint being decoded.
+    uint16_t value;     ///< Varint being decoded.
+    uint16_t remaining; ///< Samples of the block still to come.
+    uint8_t run;        ///< Codes of the run still to come.
+    uint16_t previous;  ///< Last sample produced.
+    uint32_t blocks;    ///< Blocks decoded.
+    uint32_t errors;    ///< Malformed blocks (varint too long, run longer than the block), dropped.
+} codec_decoder_t;
+
+/**
+ * @brief Encode a block of samples.
+ *
+ * @param samples Samples, any 16-bit values.
+ * @param count   Number of samples, at most 65535.
+ * @param out     Destination, at least `CODEC_BLOCK_MAX(count)` bytes.
+ * @return Encoded length.
+ */
+size_t codec_encode_block(const uint16_t* samples, size_t count, uint8_t* out);
+
+/**
+ * @brief Prepare a decoder to expect the start of a block.
+ *
+ * @param decoder Decoder to initialize.
+ */
+void codec_decoder_init(codec_decoder_t* decoder);
+
+/**
+ * @brief Feed one encoded byte to a decoder.
+ *
+ * Blocks can follow each other in the stream; the decoder knows where each one ends from its count.
+ *
+ * @param decoder Decoder to update.
+ * @param byte    Encoded byte.
+ * @param samples Receives the samples completed by the byte, up to two.
+ * @return Number of samples written to `samples`.
+ */
+size_t codec_decoder_feed(codec_decoder_t* decoder, uint8_t byte, uint16_t samples[2]);
+
+/**
+ * @brief Whether the decoder sits between two blocks.
+ *
+ * @param decoder Decoder to query.
+ * @return 1 at a block boundary, 0 inside a block.
+ */
+int codec_decoder_idle(const codec_decoder_t* decoder);
+
+#endif // MODULE_CODEC_H
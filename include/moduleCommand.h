@@ -0,0 +1,143 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleCommand.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_COMMAND_H
+#define MODULE_COMMAND_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleCommand.h
+ * @brief Hardware-independent parser of the commands received on the UART link.
+ *
+ * A command is one line of text: a verb and up to `COMMAND_MAX_ARGS` unsigned decimal arguments separated
+ * by blanks, ended by '\n' or '\r', e.g. `zone 2 1000 1080`. The parser is fed the received bytes where
+ * they lie, without copying the line: the verb is matched against the table as it arrives and the
+ * arguments are accumulated digit by digit, so the work per byte is bounded by the number of verbs and
+ * lines of any length take no memory. Verbs are case-insensitive.
+ *
+ * A line may end with a checksum, as in NMEA: `*` and two hexadecimal digits of the XOR of every character
+ * from the verb up to the `*`, e.g. `status*14`. A line with a wrong checksum is invalid; a line without one
+ * is accepted, so the commands can still be typed by hand.
+ *
+ * | Verb        | Arguments               | Effect                                                |
+ * |-------------|-------------------------|-------------------------------------------------------|
+ * | `zone`      | zone, enter mm, exit mm | Hysteresis band of a zone.                            |
+ * | `rate`      | Hz                      | Filtered sample rate of the running acquisition mode. |
+ * | `telemetry` | ms                      | Period of the telemetry snapshots, 0 stops them.      |
+ * | `mode`      | ADC_MODE_*              | Acquisition mode.                                     |
+ * | `baud`      | [bps]                   | Line rate; without argument, auto-baud detection.     |
+ * | `status`    |                         | Status packet, then the jitter, ISR, mixer reports.   |
+ * | `batch`     | samples, [ms]           | Size and age limits of the telemetry sample batches.  |
+ */
+
+/**
+ * @defgroup Command identifiers
+ * @brief Value of `command_t::id`.
+ *
+ */
+#define COMMAND_NONE      0    ///< No line completed.
+#define COMMAND_ZONE      1    ///< `zone <zone> <enter> <exit>`.
+#define COMMAND_RATE      2    ///< `rate <hz>`.
+#define COMMAND_TELEMETRY 3    ///< `telemetry <ms>`.
+#define COMMAND_MODE      4    ///< `mode <mode>`.
+#define COMMAND_BAUD      5    ///< `baud [bps]`.
+#define COMMAND_STATUS    6    ///< `status`.
+#define COMMAND_BATCH     7    ///< `batch <samples> [ms]`.
+#define COMMAND_INVALID   0xFF ///< Unknown verb, bad argument or wrong number of arguments.
+
+#define COMMAND_MAX_ARGS  3  ///< Most arguments of a command.
+#define COMMAND_REPLY_MAX 32 ///< Longest reply of @ref command_reply, newline included.
+
+/**
+ * @brief A parsed command line.
+ */
+typedef struct
+{
+    uint8_t id;                      ///< COMMAND_* of the line.
+    uint8_t argc;                    ///< Number of arguments.
+    uint32_t argv[COMMAND_MAX_ARGS]; ///< Arguments, in order.
+} command_t;
+
+/**
+ * @brief Parser state, carried from one received chunk to the next.
+ */
+typedef struct
+{
+    uint8_t state;            ///< Position in the line grammar.
+    uint8_t candidates;       ///< Verbs still matching the characters seen, one bit per verb of the table.
+    uint8_t position;         ///< Characters of the verb seen, saturated.
+    uint8_t sum;              ///< XOR of the characters of the line so far.
+    uint8_t check;            ///< Checksum received after the `*`.
+    uint8_t check_digits;     ///< Hexadecimal digits of the checksum received.
+    command_t command;        ///< Line being parsed.
+    uint32_t lines;           ///< Valid lines parsed.
+    uint32_t errors;          ///< Invalid lines.
+    uint32_t checksum_errors; ///< Invalid lines because of the checksum, also counted in `errors`.
+} command_parser_t;
+
+/**
+ * @brief Prepare a parser at the start of a line, with cleared counters.
+ *
+ * @param parser Parser to initialize.
+ */
+void command_parser_init(command_parser_t* parser);
+
+/**
+ * @brief Drop the line in progress, keeping the counters.
+ *
+ * For bytes discarded before reaching the parser, so the next line does not start with the previous one.
+ *
+ * @param parser Parser to reset.
+ */
+void command_parser_reset(command_parser_t* parser);
+
+/**
+ * @brief Feed received bytes to the parser.
+ *
+ * Consumes bytes up to the end of the first line completed, or all of them. The caller handles `command`
+ * and calls again with the bytes left; blank lines are skipped. A control character other than '\t' (for
+ * example the NUL of a break) discards the line in progress.
+ *
+ * @param parser  Parser state.
+ * @param data    Received bytes.
+ * @param length  Number of bytes.
+ * @param command Receives the completed line; `id` is `COMMAND_NONE` if no line was completed.
+ * @return Bytes consumed.
+ */
+size_t command_feed(command_parser_t* parser, const uint8_t* data, size_t length, command_t* command);
+
+/**
+ * @brief Verb of a command, for replies.
+ *
+ * @param id COMMAND_* value.
+ * @return Verb, "?" if `id` is not a command of the table.
+ */
+const char* command_name(uint8_t id);
+
+/**
+ * @brief Build the reply line to a command.
+ *
+ * `<verb>: ok`, `<verb>: rejected` or `?: invalid`, followed by `value` when it is not 0, and a newline.
+ *
+ * @param command Command that was run.
+ * @param result  0 if it was applied, -1 if it was rejected.
+ * @param value   Value obtained, when it may differ from the one asked for; 0 for none.
+ * @param out     Destination, at least `COMMAND_REPLY_MAX` characters; not NUL-terminated.
+ * @return Characters written.
+ */
+size_t command_reply(const command_t* command, int result, uint32_t value, char* out);
+
+#endif // MODULE_COMMAND_H
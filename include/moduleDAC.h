@@ -17,57 +17,160 @@
 
 #include "lpc17xx_dac.h"
 #include "lpc17xx_gpdma.h"
+#include "moduleDMA.h"
+#include "moduleMixer.h"
 #include "moduleSystick.h"
+#include "moduleTime.h"
+#include "moduleZone.h"
 
 /** @defgroup DAC and DMA configuration
  *  Constants and definitions related to DAC and DMA configuration.
  *
  */
-#define DMA_SIZE       60 /**< DMA transfer size in samples */
-#define NUM_SAMPLES    4  /**< Total samples for full wave */
-#define WAVE_FREQUENCY 60 /**< Sine wave frequency: 60 Hz */
-#define CLOCK_DAC_MHZ  25 /**< DAC clock frequency: 25 MHz (CCLK divided by 4) */
+#define CLOCK_DAC_MHZ   25                /**< DAC clock frequency: 25 MHz (CCLK divided by 4) */
+#define DAC_WAVE_POINTS 64                /**< Points of one period in the wavetables, a power of two */
+#define DAC_UPDATE_RATE 25600             /**< DAC updates per second: 400 Hz with stride 1 */
+#define DAC_MIDSCALE    512               /**< 10-bit code of the output at rest */
+#define DAC_VALUE_SHIFT 6                 /**< Position of the 10-bit code in DACR */
+#define DAC_GAIN_Q      8                 /**< Envelope gain is a Q8 fraction */
+#define DAC_GAIN_FULL   (1 << DAC_GAIN_Q) /**< Unity gain */
+#define DAC_WAVE_LOG2   6                 /**< log2(DAC_WAVE_POINTS), for the mixer's phase accumulators */
+#define DAC_MIX_BLOCK   DAC_WAVE_POINTS   /**< Samples rendered by the mixer per DMA block */
 
 /**
- * @brief Values ​​for DAC per DMA.
+ * @brief Description of a periodic waveform.
  *
+ * Every value the DAC and the DMA need is derived from it: the transfer length is one period of the
+ * table read with the given stride, the DAC timeout is the update period, and the tone frequency follows
+ * from both, so they cannot disagree.
  */
-extern volatile uint32_t dac_value[NUM_SAMPLES];
+typedef struct
+{
+    const uint16_t* table; /**< One period, 10-bit DAC codes */
+    uint16_t points;       /**< Entries of the table, a power of two */
+    uint16_t stride;       /**< Table entries advanced per DAC update, a power of two not above points */
+    uint32_t update_rate;  /**< DAC updates per second */
+} dac_wave_t;
 
 /**
- * @brief Values ​​for dac by DMA if reverse_flag = TRUE.
+ * @brief Wave played in each alarm level.
  *
  */
-extern volatile uint32_t dac_value1[NUM_SAMPLES];
+extern const dac_wave_t dac_zone_wave[ZONE_COUNT];
 
 /**
- * @brief Values ​​for the dac by DMA if reverse_flag = FALSE.
+ * @brief Ping-pong sample buffers, DACR words of one period of a wave each.
  *
+ * One spare word keeps the two address ranges apart, so the buffer the GPDMA is reading can be told from
+ * its source address even at the end of a period.
  */
-extern volatile uint32_t dac_value2[NUM_SAMPLES];
+extern volatile uint32_t dac_buffer[2][DAC_WAVE_POINTS + 1];
 
-#define CHANNEL_DMA_DAC 0 /**< DMA channel used for the DAC */
+/// GPDMA channel feeding the DAC, reserved by @ref configure_dac.
+extern uint8_t dac_dma_channel;
+
+/// Tone generators mixed into the output while `dac_mixing` is set, one voice per sensor.
+extern mixer_t dac_mixer;
+
+/// TRUE while the output is the mixed stream instead of a looping wave.
+extern volatile uint8_t dac_mixing;
+
+/// CPU cycles spent rendering each mixed block.
+extern cycle_stats_t dac_mix_stats;
 
 /**
  * @brief Set the DAC to generate a periodic wave.
  *
- * Initializes the DAC and sets its refresh interval based on the desired wave frequency.
+ * Initializes the DAC, selects the wave of the current alarm level and sets its refresh interval.
  */
 void configure_dac(void);
 
 /**
  * @brief Set the DMA to transfer data to the DAC.
  *
- * Configures the DMA to perform continuous transfers from a data table
- * containing wave samples to the DAC register.
+ * Configures the DMA to loop over the active `dac_buffer`, one period of the current wave per transfer.
+ * The channel is left disabled; it is enabled with `GPDMA_ChannelCmd(dac_dma_channel, ENABLE)`.
+ */
+void configure_dma_for_dac(void);
+
+/**
+ * @brief Number of DAC updates in one period of a wave.
+ *
+ * @param wave Waveform descriptor.
+ * @return DMA transfer length.
+ */
+uint32_t dac_wave_length(const dac_wave_t* wave);
+
+/**
+ * @brief DAC timeout between updates of a wave.
+ *
+ * @param wave Waveform descriptor.
+ * @return Value for `DAC_SetDMATimeOut`, in DAC clock cycles.
+ */
+uint32_t dac_wave_timeout(const dac_wave_t* wave);
+
+/**
+ * @brief Tone frequency of a wave.
+ *
+ * @param wave Waveform descriptor.
+ * @return Frequency in Hz.
+ */
+uint32_t dac_wave_frequency(const dac_wave_t* wave);
+
+/**
+ * @defgroup DAC envelope
+ * @brief Gain change per envelope step. Steps are taken per DMA transfer of one period, never per sample.
+ *
+ */
+#ifndef DAC_ATTACK_STEP
+#define DAC_ATTACK_STEP 32 ///< Full level after 8 steps of two periods, 40 ms at 400 Hz.
+#endif
+#ifndef DAC_RELEASE_STEP
+#define DAC_RELEASE_STEP 16 ///< Silent after 16 steps of two periods, 80 ms at 400 Hz.
+#endif
+
+/**
+ * @brief Play a wave.
+ *
+ * Renders one period into the idle buffer and relinks the chain so the GPDMA moves to it at the end of a
+ * period of the current wave. From silence the wave fades in with the attack ramp.
+ *
+ * @param wave Waveform descriptor.
+ */
+void dac_play(const dac_wave_t* wave);
+
+/**
+ * @brief Fade the current wave out with the release ramp, the output ends at midscale.
+ */
+void dac_release(void);
+
+/**
+ * @brief Switch the output to the mixed stream of `dac_mixer`.
+ *
+ * Both buffers become a ring of `DAC_MIX_BLOCK` samples and every block is rendered when the GPDMA leaves
+ * it, so the voices play continuously with their own frequencies and cadences.
+ */
+void dac_mix_start(void);
+
+/**
+ * @brief Go back to the looping wave output, silent until the next @ref dac_play.
+ */
+void dac_mix_stop(void);
+
+/**
+ * @brief GPDMA callback of the DAC channel, called from `DMA_IRQHandler`.
+ *
+ * Renders the next period of a ramp every time one ends, or the next mixed block.
  *
- * @param table Pointer to the wave sample table.
+ * @param channel Channel that interrupted.
+ * @param status  `DMA_STATUS_DONE` and/or `DMA_STATUS_ERROR`.
  */
-void configure_dma_for_dac(volatile uint32_t* table);
+void dac_on_dma(uint8_t channel, uint32_t status);
 
 /**
  * @brief Updates the data to be converted by the DAC.
  *
+ * Plays the wave of the current alarm level.
  */
 void update_dac(void);
 
@@ -0,0 +1,134 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleDMA.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_DMA_H
+#define MODULE_DMA_H
+
+#include "lpc17xx_clkpwr.h"
+#include "lpc17xx_gpdma.h"
+#include "lpc17xx_nvic.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleDMA.h
+ * @brief Shared access to the GPDMA controller.
+ *
+ * The controller is reset once by @ref configure_dma. Modules then reserve a channel according to the
+ * priority they need, take their linked list items from a static pool and receive the terminal count and
+ * error interrupts of their channel through a callback; the only `DMA_IRQHandler` lives here.
+ */
+
+/**
+ * @defgroup DMA service constants
+ * @brief Sizes of the channel table and of the linked list item pool.
+ *
+ */
+#define DMA_CHANNELS 8    ///< GPDMA channels, channel 0 has the highest hardware priority.
+#define DMA_LLI_POOL 12   ///< Linked list items shared by every channel.
+#define DMA_NONE     0xFF ///< Owner of a free pool item / result of a failed reservation.
+
+/**
+ * @defgroup DMA priorities
+ * @brief Requested priority of each user, lower is more urgent; it is the first channel tried.
+ *
+ */
+#define DMA_PRIORITY_DAC  0 ///< Continuous audio, must never starve.
+#define DMA_PRIORITY_ADC  1 ///< ADC sample blocks, a missed request loses a conversion.
+#define DMA_PRIORITY_UART 4 ///< UART transmission, can wait.
+
+/**
+ * @defgroup DMA callback status
+ * @brief Reason of a callback, as a bit mask.
+ *
+ */
+#define DMA_STATUS_DONE  ((uint32_t)(1 << 0)) ///< Terminal count: a transfer or a linked list item is complete.
+#define DMA_STATUS_ERROR ((uint32_t)(1 << 1)) ///< The transfer failed (bus error).
+
+/**
+ * @brief Completion/error callback, called from `DMA_IRQHandler`.
+ *
+ * @param channel Channel that interrupted.
+ * @param status  `DMA_STATUS_DONE` and/or `DMA_STATUS_ERROR`.
+ */
+typedef void (*dma_callback_t)(uint8_t channel, uint32_t status);
+
+/**
+ * @brief Reset the GPDMA controller and the service state, and enable its interrupt.
+ *
+ * Must run once, before any module configures a transfer.
+ */
+void configure_dma(void);
+
+/**
+ * @brief Reserve a channel.
+ *
+ * The first free channel starting at `priority` and going towards lower hardware priorities is taken,
+ * so a user never gets a channel more urgent than it asked for.
+ *
+ * @param priority Requested priority (DMA_PRIORITY_*), 0 to 7.
+ * @param callback Function called on terminal count and error interrupts, or NULL.
+ * @return Channel number, `DMA_NONE` if every suitable channel is taken.
+ */
+uint8_t dma_channel_reserve(uint8_t priority, dma_callback_t callback);
+
+/**
+ * @brief Stop a channel and give it back, with its linked list items.
+ *
+ * @param channel Channel returned by @ref dma_channel_reserve.
+ */
+void dma_channel_release(uint8_t channel);
+
+/**
+ * @brief Take consecutive linked list items from the pool.
+ *
+ * Items stay with the channel until it is released; they are statically allocated and word aligned, as
+ * the GPDMA requires.
+ *
+ * @param channel Owner of the items.
+ * @param count   Number of consecutive items.
+ * @return First item, NULL if the pool has no run of `count` free items.
+ */
+GPDMA_LLI_Type* dma_lli_alloc(uint8_t channel, uint8_t count);
+
+/**
+ * @brief Registers of a channel.
+ *
+ * @param channel Channel number.
+ * @return Pointer to the channel registers.
+ */
+LPC_GPDMACH_TypeDef* dma_channel_regs(uint8_t channel);
+
+/**
+ * @brief Mask the GPDMA interrupt, nest-safe.
+ *
+ * Keeps the callbacks out of a section that shares state with them. Sections may nest, also across
+ * interrupt priorities: a handler that preempts a masked section and masks and unmasks on its own leaves
+ * the interrupt masked, it is only unmasked by the outermost @ref dma_irq_unlock.
+ */
+void dma_irq_lock(void);
+
+/**
+ * @brief End a section started by @ref dma_irq_lock.
+ */
+void dma_irq_unlock(void);
+
+/**
+ * @brief GPDMA Interrupt Handler.
+ *
+ * Acknowledges the terminal count and error flags of every channel and calls its callback.
+ */
+void DMA_IRQHandler(void);
+
+#endif // MODULE_DMA_H
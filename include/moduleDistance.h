@@ -0,0 +1,57 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleDistance.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_DISTANCE_H
+#define MODULE_DISTANCE_H
+
+#include <stdint.h>
+
+/**
+ * @file moduleDistance.h
+ * @brief Hardware-independent conversion of ADC counts into millimetres.
+ *
+ * The sensor curve is described by calibration points taken every `2^DISTANCE_STEP_LOG` counts and
+ * linearly interpolated between them. The points are a constant table in flash; because they are
+ * equally spaced by a power of two, a conversion is one shift to find the segment, one multiply and one
+ * shift to interpolate inside it, with no division.
+ */
+
+/**
+ * @defgroup Distance calibration
+ * @brief Sensor calibration, from the nearest reading (0 counts) to the farthest (4096 counts).
+ *
+ */
+#define DISTANCE_STEP_LOG   9    ///< Calibration points every 512 counts.
+#define DISTANCE_FULL_SCALE 4096 ///< ADC counts of the full scale (12 bits).
+#define DISTANCE_POINTS     ((DISTANCE_FULL_SCALE >> DISTANCE_STEP_LOG) + 1) ///< Including both ends.
+
+/**
+ * @brief Distance in millimetres at 0, 512, 1024... 4096 counts, `DISTANCE_POINTS` values.
+ *
+ * Lower counts mean a nearer obstacle. Replace with the measurements of the actual sensor; a different
+ * `DISTANCE_STEP_LOG` needs the matching number of points, which is checked at build time.
+ */
+#ifndef DISTANCE_CALIBRATION
+#define DISTANCE_CALIBRATION 100, 300, 550, 800, 1100, 1450, 1900, 2400, 3000
+#endif
+
+/**
+ * @brief Convert a 12-bit reading into millimetres.
+ *
+ * @param counts ADC reading, values above 4095 are clamped.
+ * @return Distance in millimetres.
+ */
+uint16_t distance_mm_from_counts(uint16_t counts);
+
+#endif // MODULE_DISTANCE_H
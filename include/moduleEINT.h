@@ -21,6 +21,7 @@
 #include "lpc17xx_nvic.h"
 #include "lpc17xx_systick.h"
 #include "lpc17xx_timer.h"
+#include "moduleEvent.h"
 #include "modulePort.h"
 #include <stddef.h>
 #include <stdint.h>
@@ -0,0 +1,86 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleEvent.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_EVENT_H
+#define MODULE_EVENT_H
+
+#include "LPC17xx.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleEvent.h
+ * @brief Deferred notification of system events.
+ *
+ * Interrupt handlers raise events as bits of a pending mask and pend the PendSV exception. PendSV runs at
+ * the lowest priority, once every higher priority handler has returned, and calls the handlers subscribed
+ * to the raised events. Nothing runs while no event is raised.
+ */
+
+/**
+ * @defgroup System events
+ * @brief One bit per event.
+ *
+ */
+#define EVENT_ZONE_CHANGE ((uint32_t)(1 << 0)) ///< proximity_zone or alarm_level changed.
+#define EVENT_ADC_SAMPLES ((uint32_t)(1 << 1)) ///< Raw conversions waiting in adc_raw_ring.
+#define EVENT_ENABLE      ((uint32_t)(1 << 2)) ///< The system was enabled or disabled (habilitar).
+#define EVENT_TELEMETRY   ((uint32_t)(1 << 3)) ///< A SysTick period passed or a telemetry batch is waiting.
+#define EVENT_BAUD        ((uint32_t)(1 << 4)) ///< A UART line rate change or auto-baud step is waiting.
+#define EVENT_COMMAND     ((uint32_t)(1 << 5)) ///< Received bytes waiting in uart_rx_ring.
+
+#define EVENT_MAX_HANDLERS 8  ///< Maximum number of subscriptions.
+#define EVENT_PRIORITY     31 ///< PendSV priority, the lowest of the LPC1769 (5 priority bits).
+
+/**
+ * @brief Event handler.
+ *
+ * @param events Mask of the raised events the handler is subscribed to.
+ */
+typedef void (*event_handler_t)(uint32_t events);
+
+/**
+ * @brief Set the PendSV priority and clear the subscriptions.
+ */
+void configure_events(void);
+
+/**
+ * @brief Subscribe a handler to a set of events.
+ *
+ * Handlers are called in subscription order. Subscriptions are made during the initialization, before the
+ * events can be raised.
+ *
+ * @param events  Mask of the events of interest.
+ * @param handler Function to call.
+ * @return 0 on success, -1 if every subscription slot is in use.
+ */
+int event_subscribe(uint32_t events, event_handler_t handler);
+
+/**
+ * @brief Raise events, from an interrupt handler or from thread mode.
+ *
+ * Events raised again before PendSV runs are merged into a single notification.
+ *
+ * @param events Mask of the events to raise.
+ */
+void event_raise(uint32_t events);
+
+/**
+ * @brief PendSV exception handler.
+ *
+ * Takes the pending events and calls every subscribed handler.
+ */
+void PendSV_Handler(void);
+
+#endif // MODULE_EVENT_H
@@ -0,0 +1,91 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleFormat.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_FORMAT_H
+#define MODULE_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleFormat.h
+ * @brief Hardware-independent integer to text conversion.
+ *
+ * A few fixed conversions instead of `sprintf`: no format string to parse, no varargs, no heap and no
+ * locale, and only the code that is called gets linked. Every function writes straight into the caller
+ * buffer, does not add a terminating NUL and returns the number of characters written, so calls chain by
+ * advancing a pointer. Buffers must have room for the longest result (`FORMAT_*_MAX`).
+ */
+
+/**
+ * @defgroup Format constants
+ * @brief Longest result of every conversion.
+ *
+ */
+#define FORMAT_UNSIGNED_MAX 10 ///< Digits of the largest uint32_t.
+#define FORMAT_SIGNED_MAX   11 ///< Sign and digits of the most negative int32_t.
+#define FORMAT_HEX_MAX      8  ///< Hexadecimal digits of a uint32_t.
+#define FORMAT_FIXED_MAX    12 ///< Sign, digits and decimal point of an int32_t.
+
+/**
+ * @brief Unsigned decimal.
+ *
+ * @param out   Destination, at least `FORMAT_UNSIGNED_MAX` characters.
+ * @param value Value to convert.
+ * @return Characters written.
+ */
+size_t format_unsigned(char* out, uint32_t value);
+
+/**
+ * @brief Signed decimal, with a leading '-' for negative values.
+ *
+ * @param out   Destination, at least `FORMAT_SIGNED_MAX` characters.
+ * @param value Value to convert.
+ * @return Characters written.
+ */
+size_t format_signed(char* out, int32_t value);
+
+/**
+ * @brief Uppercase hexadecimal, without prefix.
+ *
+ * @param out    Destination, at least `FORMAT_HEX_MAX` characters.
+ * @param value  Value to convert.
+ * @param digits Minimum number of digits, zero padded; 0 behaves as 1, above 8 as 8.
+ * @return Characters written.
+ */
+size_t format_hex(char* out, uint32_t value, uint8_t digits);
+
+/**
+ * @brief Fixed-point decimal.
+ *
+ * `value` is a number of `10^-decimals` units: 1234 with 3 decimals is written "1.234", -5 with 2 decimals
+ * "-0.05".
+ *
+ * @param out      Destination, at least `FORMAT_FIXED_MAX` characters.
+ * @param value    Scaled value.
+ * @param decimals Digits after the point, 0 to 9; 0 writes a plain integer.
+ * @return Characters written.
+ */
+size_t format_fixed(char* out, int32_t value, uint8_t decimals);
+
+/**
+ * @brief Copy a string, without its NUL.
+ *
+ * @param out  Destination, at least `strlen(text)` characters.
+ * @param text NUL-terminated text.
+ * @return Characters written.
+ */
+size_t format_text(char* out, const char* text);
+
+#endif // MODULE_FORMAT_H
@@ -0,0 +1,120 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleMixer.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_MIXER_H
+#define MODULE_MIXER_H
+
+#include "moduleCadence.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleMixer.h
+ * @brief Hardware-independent mixing of several tone generators into one DAC sample stream.
+ *
+ * Every voice is a direct digital synthesis oscillator (32-bit phase accumulator over a wavetable) with its
+ * own frequency, amplitude and beep cadence, so with one voice per bumper sensor the driver hears which
+ * side is closest. Voices are summed in fixed point around midscale and the sum saturates at the DAC
+ * range instead of wrapping.
+ *
+ * The mixer renders whole blocks: voice state is only loaded and stored once per block and the cadence
+ * gate and the amplitude ramp are evaluated per block, the inner loop is one table read, one multiply and
+ * one addition per voice and sample.
+ */
+
+/**
+ * @defgroup Mixer constants
+ * @brief Limits of the mixer.
+ *
+ */
+#ifndef MIXER_VOICES
+#define MIXER_VOICES 8 ///< Voices of a mixer, one per AD0 channel.
+#endif
+#define MIXER_MAX_BLOCK 64                  ///< Largest block rendered at once (accumulator on the stack).
+#define MIXER_GAIN_Q    8                   ///< Voice gain is a Q8 fraction.
+#define MIXER_GAIN_FULL (1 << MIXER_GAIN_Q) ///< Unity gain of a voice.
+#define MIXER_RAMP_STEP 64                  ///< Gain change per block when a voice is gated, avoids clicks.
+
+/**
+ * @brief One tone generator.
+ */
+typedef struct
+{
+    uint32_t phase;       ///< Position in the wavetable, the upper bits index it.
+    uint32_t phase_step;  ///< Phase advanced per sample, frequency * 2^32 / sample rate.
+    uint32_t on_samples;  ///< Beep length in samples.
+    uint32_t off_samples; ///< Silence length in samples, 0 for a solid tone.
+    uint32_t position;    ///< Samples into the current beep + silence cycle.
+    uint16_t gain;        ///< Amplitude during a beep, Q8; 0 mutes the voice.
+    uint16_t level;       ///< Amplitude of the last block, moves towards `gain` or 0 by MIXER_RAMP_STEP.
+} mixer_voice_t;
+
+/**
+ * @brief Mixer state and counters.
+ */
+typedef struct
+{
+    mixer_voice_t voice[MIXER_VOICES]; ///< Tone generators.
+    const uint16_t* table;             ///< One period of the wave, DAC codes around `midscale`.
+    uint8_t index_shift;               ///< 32 - log2(table points), phase to table index.
+    uint16_t midscale;                 ///< DAC code at rest; the output range is 0 to 2 * midscale - 1.
+    uint32_t sample_rate;              ///< Samples per second of the output stream.
+    uint32_t blocks;                   ///< Blocks rendered.
+    uint32_t clipped;                  ///< Output samples that saturated.
+} mixer_t;
+
+/**
+ * @brief Prepare a mixer with every voice muted.
+ *
+ * @param mixer       Mixer to initialize.
+ * @param table       One period of the wave, 2^points_log2 DAC codes.
+ * @param points_log2 Table length as a power of two.
+ * @param midscale    DAC code at rest.
+ * @param sample_rate Output samples per second.
+ */
+void mixer_init(mixer_t* mixer, const uint16_t* table, uint8_t points_log2, uint16_t midscale,
+                uint32_t sample_rate);
+
+/**
+ * @brief Set the tone of a voice.
+ *
+ * The phase is kept, so a change of frequency does not jump the waveform.
+ *
+ * @param mixer        Mixer.
+ * @param voice        Voice index, below MIXER_VOICES.
+ * @param frequency_hz Tone frequency, 0 mutes the voice.
+ * @param gain         Amplitude during a beep, Q8.
+ */
+void mixer_set_tone(mixer_t* mixer, uint8_t voice, uint32_t frequency_hz, uint16_t gain);
+
+/**
+ * @brief Set the beep cadence of a voice from a distance (see moduleCadence).
+ *
+ * @param mixer       Mixer.
+ * @param voice       Voice index, below MIXER_VOICES.
+ * @param distance_mm Distance to the obstacle seen by that voice's sensor.
+ */
+void mixer_set_distance(mixer_t* mixer, uint8_t voice, uint16_t distance_mm);
+
+/**
+ * @brief Render one block of the mixed stream.
+ *
+ * @param mixer Mixer.
+ * @param out   Destination, one word per sample: the DAC code shifted left by `shift` (DACR layout).
+ * @param count Samples to render, at most MIXER_MAX_BLOCK.
+ * @param shift Position of the code in each word.
+ */
+void mixer_render(mixer_t* mixer, volatile uint32_t* out, size_t count, uint8_t shift);
+
+#endif // MODULE_MIXER_H
@@ -28,9 +28,25 @@
 #define GREEN_LED_PIN     ((uint32_t)(1 << 4))  /**< Green LED controlled by Systick, pin 0.4, output - function 0 */
 #define RED_LED_PIN       ((uint32_t)(1 << 5))  /**< Red LED controlled by Systick, pin 0.5, output - function 0 */
 #define BUZZER_PIN        ((uint32_t)(1 << 26)) /**< DAC for buzzer, pin 0.26, output - function 2 */
+#define BUZZER_PWM_PIN    ((uint32_t)(1 << 0))  /**< PWM1.1 for buzzer, pin 2.0, output - function 1 */
 #define TX_PIN            ((uint32_t)(1 << 2))  /**< UART transmit pin at 0.2, output - function 1 */
 #define RX_PIN            ((uint32_t)(1 << 3))  /**< UART receive pin at 0.3, input - function 1 */
 
+/**
+ * @brief Pin routing of one AD0 input.
+ */
+typedef struct
+{
+    uint8_t port;     /**< Port of the pin */
+    uint8_t pin;      /**< Pin number inside the port */
+    uint8_t function; /**< Pin function that selects the AD0 input */
+} adc_pin_t;
+
+/**
+ * @brief Pin of every AD0 channel, indexed by channel number.
+ */
+extern const adc_pin_t adc_channel_pins[8];
+
 /**
  * @brief Configure the ports necessary for system operation.
  * This function initializes the pins used in the project, setting the address of each pin (input or output)
@@ -0,0 +1,239 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleProtocol.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_PROTOCOL_H
+#define MODULE_PROTOCOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleProtocol.h
+ * @brief Hardware-independent binary frame format of the UART link.
+ *
+ * A packet is a header (type, sequence number, microsecond timestamp), a packed payload and a CRC-16 of
+ * both. It is COBS encoded, so it contains no zero byte, and followed by a zero delimiter: a receiver that
+ * starts in the middle of the stream or loses bytes resynchronizes at the next delimiter. Multi-byte fields
+ * are little-endian.
+ *
+ * Frame on the wire:
+ * COBS( type | sequence | timestamp (4) | payload | CRC-16 (2) ) | 0x00
+ *
+ * The CRC is CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF). Both ends use this module:
+ * the firmware encodes, the host tools decode.
+ */
+
+/**
+ * @defgroup Protocol constants
+ * @brief Frame format.
+ *
+ */
+#define PROTOCOL_DELIMITER   0x00   ///< Ends every frame; never appears inside one.
+#define PROTOCOL_HEADER_SIZE 6      ///< Type, sequence and timestamp.
+#define PROTOCOL_CRC_SIZE    2      ///< CRC-16 after the payload.
+#define PROTOCOL_CRC_INIT    0xFFFF ///< Initial CRC value.
+#define PROTOCOL_MAX_PAYLOAD 120    ///< Largest payload, a log line.
+
+/**
+ * @brief Worst case size on the wire of a packet with `payload` bytes, delimiter included.
+ *
+ * COBS adds one byte, plus one for every 254 bytes of data.
+ */
+#define PROTOCOL_FRAME_SIZE(payload) (PROTOCOL_PACKET_SIZE(payload) + PROTOCOL_PACKET_SIZE(payload) / 254 + 2)
+
+/**
+ * @brief Size of a packet with `payload` bytes before COBS encoding.
+ */
+#define PROTOCOL_PACKET_SIZE(payload) ((payload) + PROTOCOL_HEADER_SIZE + PROTOCOL_CRC_SIZE)
+
+#define PROTOCOL_FRAME_MAX PROTOCOL_FRAME_SIZE(PROTOCOL_MAX_PAYLOAD) ///< Largest frame.
+
+/**
+ * @defgroup Packet types
+ * @brief First byte of the header.
+ *
+ */
+#define PROTOCOL_TYPE_SNAPSHOT 0x01 ///< Periodic @ref protocol_snapshot_t.
+#define PROTOCOL_TYPE_STATUS   0x02 ///< @ref protocol_status_t, sent on every zone change.
+#define PROTOCOL_TYPE_LOG      0x03 ///< Free text, as printed by the firmware, without NUL.
+#define PROTOCOL_TYPE_BATCH    0x04 ///< moduleBatch frame: time stamped samples, zone changes and counters.
+
+/**
+ * @defgroup Payload sizes
+ * @brief Packed size of every fixed payload.
+ *
+ */
+#define PROTOCOL_SNAPSHOT_SIZE 21 ///< Packed @ref protocol_snapshot_t.
+#define PROTOCOL_STATUS_SIZE   18 ///< Packed @ref protocol_status_t.
+
+#define PROTOCOL_FLAG_ENABLED    ((uint8_t)(1 << 0)) ///< Snapshot flag: the system is enabled.
+#define PROTOCOL_FLAG_MODE_SHIFT 1                   ///< Snapshot flags: acquisition mode in bits 3:1.
+
+/**
+ * @brief Packet header.
+ */
+typedef struct
+{
+    uint8_t type;       ///< PROTOCOL_TYPE_*.
+    uint8_t sequence;   ///< Packet number on the link, wraps; a gap tells the receiver packets were lost.
+    uint32_t timestamp; ///< Microsecond timestamp of the packet.
+} protocol_header_t;
+
+/**
+ * @brief Periodic state of the system.
+ */
+typedef struct
+{
+    uint16_t value;         ///< Latest 12-bit ADC value.
+    uint16_t distance;      ///< Distance in millimetres.
+    uint8_t zone;           ///< Proximity zone.
+    uint8_t level;          ///< Alarm level.
+    uint16_t closing_speed; ///< Closing speed in mm/s.
+    uint16_t ttc_ms;        ///< Time to collision in milliseconds.
+    uint8_t flags;          ///< PROTOCOL_FLAG_* and acquisition mode.
+    uint32_t adc_overruns;  ///< Samples dropped by the ADC ring.
+    uint32_t uart_dropped;  ///< Bytes dropped by the UART transmit ring.
+    uint16_t skipped;       ///< Snapshots skipped because the UART channel was busy.
+} protocol_snapshot_t;
+
+/**
+ * @brief Zone change report.
+ */
+typedef struct
+{
+    uint16_t value;         ///< Newest 12-bit ADC value.
+    uint16_t distance;      ///< Distance of the newest sample, in millimetres.
+    uint8_t zone;           ///< New proximity zone.
+    uint8_t level;          ///< New alarm level.
+    uint16_t closing_speed; ///< Closing speed in mm/s.
+    uint16_t ttc_ms;        ///< Time to collision in milliseconds.
+    uint32_t samples;       ///< Samples taken since the previous report.
+    uint32_t overruns;      ///< Samples dropped by the ADC ring so far.
+} protocol_status_t;
+
+/**
+ * @brief Stream decoder state.
+ *
+ * Collects bytes up to a delimiter and decodes the frame in place.
+ */
+typedef struct
+{
+    uint8_t buffer[PROTOCOL_FRAME_MAX]; ///< Bytes of the current frame.
+    size_t fill;                        ///< Bytes in `buffer`.
+    uint8_t overflow;                   ///< The current frame is longer than any valid frame.
+    uint32_t frames;                    ///< Valid frames decoded.
+    uint32_t crc_errors;                ///< Frames discarded because of the CRC.
+    uint32_t framing_errors;            ///< Frames discarded because of their COBS encoding or length.
+} protocol_decoder_t;
+
+/**
+ * @brief Update a CRC-16/CCITT-FALSE.
+ *
+ * @param crc    Current value, `PROTOCOL_CRC_INIT` for the first block.
+ * @param data   Bytes to add.
+ * @param length Number of bytes.
+ * @return Updated CRC.
+ */
+uint16_t protocol_crc16(uint16_t crc, const uint8_t* data, size_t length);
+
+/**
+ * @brief COBS encode a block, without delimiter.
+ *
+ * @param data   Bytes to encode.
+ * @param length Number of bytes.
+ * @param out    Destination, at least `length + length / 254 + 1` bytes; must not overlap `data`.
+ * @return Encoded length.
+ */
+size_t cobs_encode(const uint8_t* data, size_t length, uint8_t* out);
+
+/**
+ * @brief COBS decode a block, without delimiter.
+ *
+ * @param data   Encoded bytes.
+ * @param length Number of encoded bytes.
+ * @param out    Destination, at least `length` bytes; may be the same array as `data`.
+ * @return Decoded length, or -1 if the block is not valid COBS.
+ */
+int cobs_decode(const uint8_t* data, size_t length, uint8_t* out);
+
+/**
+ * @brief Build a complete frame.
+ *
+ * @param header  Packet header.
+ * @param payload Payload bytes.
+ * @param length  Payload length, at most `PROTOCOL_MAX_PAYLOAD`.
+ * @param frame   Destination, at least `PROTOCOL_FRAME_SIZE(length)` bytes.
+ * @return Frame length, delimiter included; 0 if the payload is too long.
+ */
+size_t protocol_encode(const protocol_header_t* header, const uint8_t* payload, size_t length, uint8_t* frame);
+
+/**
+ * @brief Prepare a stream decoder.
+ *
+ * @param decoder Decoder to initialize.
+ */
+void protocol_decoder_init(protocol_decoder_t* decoder);
+
+/**
+ * @brief Feed one received byte to a stream decoder.
+ *
+ * @param decoder Decoder to update.
+ * @param byte    Received byte.
+ * @param header  Receives the header of a completed frame.
+ * @param payload Receives the address of its payload, valid until the next call.
+ * @param length  Receives the payload length.
+ * @return 1 when a valid frame has just completed, 0 otherwise.
+ */
+int protocol_decoder_feed(protocol_decoder_t* decoder, uint8_t byte, protocol_header_t* header,
+                          const uint8_t** payload, size_t* length);
+
+/**
+ * @brief Pack a snapshot payload.
+ *
+ * @param snapshot Snapshot to pack.
+ * @param out      Destination, `PROTOCOL_SNAPSHOT_SIZE` bytes.
+ * @return `PROTOCOL_SNAPSHOT_SIZE`.
+ */
+size_t protocol_pack_snapshot(const protocol_snapshot_t* snapshot, uint8_t* out);
+
+/**
+ * @brief Unpack a snapshot payload.
+ *
+ * @param payload  Payload bytes.
+ * @param length   Payload length.
+ * @param snapshot Unpacked snapshot.
+ * @return 0 on success, -1 if the length does not match.
+ */
+int protocol_unpack_snapshot(const uint8_t* payload, size_t length, protocol_snapshot_t* snapshot);
+
+/**
+ * @brief Pack a status payload.
+ *
+ * @param status Status to pack.
+ * @param out    Destination, `PROTOCOL_STATUS_SIZE` bytes.
+ * @return `PROTOCOL_STATUS_SIZE`.
+ */
+size_t protocol_pack_status(const protocol_status_t* status, uint8_t* out);
+
+/**
+ * @brief Unpack a status payload.
+ *
+ * @param payload Payload bytes.
+ * @param length  Payload length.
+ * @param status  Unpacked status.
+ * @return 0 on success, -1 if the length does not match.
+ */
+int protocol_unpack_status(const uint8_t* payload, size_t length, protocol_status_t* status);
+
+#endif // MODULE_PROTOCOL_H
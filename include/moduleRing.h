@@ -0,0 +1,169 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleRing.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_RING_H
+#define MODULE_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleRing.h
+ * @brief Hardware-independent single-producer/single-consumer rings of timestamped samples and of bytes.
+ *
+ * The producer (an interrupt handler) only writes `head` and the consumer only writes `tail`. Both indices
+ * run freely and are reduced with a power-of-two mask, so no lock and no interrupt masking is needed: each
+ * side reads the index of the other, works on the slots it owns and publishes its own index after a
+ * memory barrier. A push into a full ring is dropped and counted.
+ */
+
+/**
+ * @brief One sample of the processing chain.
+ */
+typedef struct
+{
+    uint32_t timestamp; ///< Microsecond timestamp of the sample.
+    uint16_t value;     ///< 12-bit ADC value.
+    uint16_t distance;  ///< Distance in millimetres.
+    uint8_t zone;       ///< Proximity zone.
+    uint8_t level;      ///< Alarm level.
+} ring_sample_t;
+
+/**
+ * @brief Ring state.
+ */
+typedef struct
+{
+    volatile uint32_t head;     ///< Samples ever pushed, written by the producer only.
+    volatile uint32_t tail;     ///< Samples ever popped, written by the consumer only.
+    volatile uint32_t overruns; ///< Samples dropped because the ring was full, written by the producer only.
+    uint32_t mask;              ///< Number of slots minus one.
+    ring_sample_t* slots;       ///< Storage, a power-of-two number of slots.
+} sample_ring_t;
+
+/**
+ * @brief Prepare an empty ring.
+ *
+ * @param ring    Ring to initialize.
+ * @param storage Array of `size` slots.
+ * @param size    Number of slots, a power of two.
+ * @return 0 on success, -1 if `size` is not a power of two.
+ */
+int ring_init(sample_ring_t* ring, ring_sample_t* storage, uint32_t size);
+
+/**
+ * @brief Append a sample (producer side).
+ *
+ * @param ring   Ring to write.
+ * @param sample Sample to copy into the ring.
+ * @return 0 on success, -1 if the ring was full and the sample was dropped.
+ */
+int ring_push(sample_ring_t* ring, const ring_sample_t* sample);
+
+/**
+ * @brief Take up to `max` of the oldest samples (consumer side).
+ *
+ * @param ring Ring to read.
+ * @param out  Destination array, at least `max` elements long.
+ * @param max  Maximum number of samples to take.
+ * @return Number of samples copied into `out`.
+ */
+size_t ring_pop_batch(sample_ring_t* ring, ring_sample_t* out, size_t max);
+
+/**
+ * @brief Number of samples waiting in the ring.
+ *
+ * Exact from the consumer side; from anywhere else it is a snapshot.
+ *
+ * @param ring Ring to inspect.
+ * @return Samples pushed and not yet popped.
+ */
+uint32_t ring_count(const sample_ring_t* ring);
+
+/**
+ * @brief Byte ring, same single-producer/single-consumer scheme as @ref sample_ring_t.
+ *
+ * Writes are all or nothing, so a message that does not fit is dropped whole instead of reaching the
+ * consumer cut in half.
+ */
+typedef struct
+{
+    volatile uint32_t head;    ///< Bytes ever written, written by the producer only.
+    volatile uint32_t tail;    ///< Bytes ever read, written by the consumer only.
+    volatile uint32_t dropped; ///< Bytes refused because the ring was full, written by the producer only.
+    uint32_t mask;             ///< Number of bytes minus one.
+    uint8_t* bytes;            ///< Storage, a power-of-two number of bytes.
+} byte_ring_t;
+
+/**
+ * @brief Prepare an empty byte ring.
+ *
+ * @param ring    Ring to initialize.
+ * @param storage Array of `size` bytes.
+ * @param size    Number of bytes, a power of two.
+ * @return 0 on success, -1 if `size` is not a power of two.
+ */
+int byte_ring_init(byte_ring_t* ring, uint8_t* storage, uint32_t size);
+
+/**
+ * @brief Append a block of bytes (producer side).
+ *
+ * @param ring   Ring to write.
+ * @param data   Bytes to copy into the ring.
+ * @param length Number of bytes.
+ * @return `length` on success, 0 if there was not room for all of them and nothing was written.
+ */
+size_t byte_ring_write(byte_ring_t* ring, const uint8_t* data, size_t length);
+
+/**
+ * @brief Take up to `max` of the oldest bytes (consumer side).
+ *
+ * @param ring Ring to read.
+ * @param out  Destination array, at least `max` bytes long.
+ * @param max  Maximum number of bytes to take.
+ * @return Number of bytes copied into `out`.
+ */
+size_t byte_ring_read(byte_ring_t* ring, uint8_t* out, size_t max);
+
+/**
+ * @brief Locate the oldest bytes without taking them (consumer side).
+ *
+ * Gives the longest run that is contiguous in the storage, so it can be handed to a DMA transfer as is.
+ * The bytes stay in the ring until @ref byte_ring_skip releases them.
+ *
+ * @param ring Ring to read.
+ * @param data Receives the address of the oldest byte.
+ * @return Number of contiguous bytes at `*data`, 0 if the ring is empty.
+ */
+size_t byte_ring_peek(const byte_ring_t* ring, const uint8_t** data);
+
+/**
+ * @brief Release bytes located with @ref byte_ring_peek (consumer side).
+ *
+ * @param ring  Ring to update.
+ * @param count Number of bytes consumed, at most the value returned by the peek.
+ */
+void byte_ring_skip(byte_ring_t* ring, size_t count);
+
+/**
+ * @brief Number of bytes waiting in the ring.
+ *
+ * Exact from the consumer side; from anywhere else it is a snapshot.
+ *
+ * @param ring Ring to inspect.
+ * @return Bytes written and not yet read.
+ */
+uint32_t byte_ring_count(const byte_ring_t* ring);
+
+#endif // MODULE_RING_H
@@ -0,0 +1,100 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleSignal.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_SIGNAL_H
+#define MODULE_SIGNAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleSignal.h
+ * @brief Hardware-independent processing of ADC sample blocks.
+ *
+ * This module only depends on the C standard library, so it is compiled both for the LPC1769 and for the
+ * host (`make host`), where recorded sample blocks can be processed exactly as on the target.
+ */
+
+/**
+ * @defgroup Signal module constants
+ * @brief Constants and definitions related to sample block processing.
+ *
+ */
+#define SIGNAL_RESULT_SHIFT 4     ///< Position of the 12-bit result inside an ADGDR/ADDRx word.
+#define SIGNAL_RESULT_MASK  0xFFF ///< Mask of the 12-bit conversion result.
+#define SIGNAL_MAX_LOG2     12    ///< Largest decimation ratio (2^12), keeps the window sum within 24 bits.
+
+/**
+ * @brief Extract the 12-bit conversion result from a raw ADC data register word.
+ */
+#define SIGNAL_RESULT(word) ((uint16_t)(((word) >> SIGNAL_RESULT_SHIFT) & SIGNAL_RESULT_MASK))
+
+/**
+ * @brief Boxcar decimator: sums `2^log2_ratio` samples and outputs their mean.
+ *
+ * It is a first order CIC filter followed by decimation by the same ratio, done in integer arithmetic only:
+ * one addition per input sample and one shift per output sample. The output stays in 12-bit counts, so
+ * the following stages do not depend on the ratio.
+ */
+typedef struct
+{
+    uint32_t sum;       ///< Sum of the samples of the current window.
+    uint16_t fill;      ///< Number of samples in the current window.
+    uint8_t log2_ratio; ///< Decimation ratio as a power of two.
+} signal_decimator_t;
+
+/**
+ * @brief Unpack raw ADC data register words into 12-bit samples.
+ *
+ * @param words   Raw words as moved by the GPDMA from the ADC global data register.
+ * @param samples Destination array, at least `count` elements long. May alias `words` only if both start at
+ *                the same address.
+ * @param count   Number of words to unpack.
+ */
+void signal_unpack_block(const volatile uint32_t* words, uint16_t* samples, size_t count);
+
+/**
+ * @brief Prepare a decimator with an empty window.
+ *
+ * @param dec        Decimator to initialize.
+ * @param log2_ratio Decimation ratio as a power of two, clamped to `SIGNAL_MAX_LOG2`. 0 lets every
+ *                   sample through.
+ */
+void signal_decimator_init(signal_decimator_t* dec, uint8_t log2_ratio);
+
+/**
+ * @brief Feed one sample to a decimator.
+ *
+ * @param dec    Decimator to update.
+ * @param sample 12-bit sample.
+ * @param out    Receives the decimated sample when the window is complete.
+ * @return 1 if `out` was written, 0 otherwise.
+ */
+int signal_decimate(signal_decimator_t* dec, uint16_t sample, uint16_t* out);
+
+/**
+ * @brief Feed a block of samples to a decimator.
+ *
+ * The window carries over between calls, so blocks do not need to be a multiple of the ratio.
+ *
+ * @param dec     Decimator to update.
+ * @param samples 12-bit samples.
+ * @param count   Number of samples.
+ * @param out     Destination of the decimated samples, at least `count / ratio + 1` elements long.
+ *                May be the same array as `samples`.
+ * @return Number of decimated samples written to `out`.
+ */
+size_t signal_decimate_block(signal_decimator_t* dec, const uint16_t* samples, size_t count, uint16_t* out);
+
+#endif // MODULE_SIGNAL_H
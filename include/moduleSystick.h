@@ -21,6 +21,7 @@
 #include "moduleDAC.h"
 #include "modulePort.h"
 #include "moduleUART.h"
+#include "moduleZone.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -41,8 +42,8 @@
 /** Maximum value for red LED counter */
 #define MAX_RED_LED_COUNTER 10
 
-/** Maximum amount of toggle */
-#define MAX_TOGGLE 1
+/** SysTick periods between LED toggles in each alarm level, the nearer the faster */
+#define ZONE_LED_TICKS {MAX_RED_LED_COUNTER, 6, MAX_GREEN_LED_COUNTER, 4}
 
 /** GPIO pin definitions */
 #define GREEN_LED_PIN ((uint32_t)(1 << 4))
@@ -51,10 +52,9 @@
 #define RED_LED_PIN ((uint32_t)(1 << 5))
 
 /** SysTick global variables */
-extern volatile uint16_t red_led_counter;   ///< Counter for changing the red LED
-extern volatile uint16_t green_led_counter; ///< Green LED change counter
-extern volatile uint8_t toggle;             ///< Toggle state variable
-extern volatile uint8_t reverse_flag;       ///< Reverse mode flag
+extern volatile uint16_t led_counter;   ///< SysTick periods left until the next LED toggle
+extern volatile uint8_t proximity_zone; ///< Current proximity zone (ZONE_*)
+extern volatile uint8_t alarm_level;    ///< Zone the alarm acts as, raised by the time to collision
 
 /**
  * @brief Set the SysTick timer.
@@ -66,23 +66,33 @@ void configure_systick(void);
 /**
  * @brief SysTick Interrupt Handler.
  *
- * Handles periodic tasks, such as changing the state of LEDs.
+ * Blinks the LED selected for the current alarm level while enabled, paces the telemetry frames and the UART line
+ * rate changes.
  * Clear SysTick interrupt flag on completion.
  */
 void SysTick_Handler(void);
 
 /**
- * @brief Change the state of the green LED.
+ * @brief Select the LED and blink period of an alarm level.
  *
- * This function changes the state of the green LED, alternating between on and off based on the toggle counter.
+ * Green from `ZONE_WARNING` on, red below; the other LED is switched off.
+ *
+ * @param level Alarm level (ZONE_*).
+ */
+void led_select(uint8_t level);
+
+/**
+ * @brief Change the state of the selected LED.
+ *
+ * This function toggles the selected LED every time its counter runs out.
  */
-void green_led(void);
+void led_blink(void);
 
 /**
- * @brief Change the state of the red LED.
+ * @brief Zone change consumer of the LEDs.
  *
- * This feature changes the state of the red LED, alternating between on and off based on the toggle counter.
+ * @param events Raised events (EVENT_ZONE_CHANGE).
  */
-void red_led(void);
+void led_on_zone_change(uint32_t events);
 
 #endif // SYSTICK_H
@@ -0,0 +1,159 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleTelemetry.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_TELEMETRY_H
+#define MODULE_TELEMETRY_H
+
+#include "moduleADC.h"
+#include "moduleBatch.h"
+#include "moduleEINT.h"
+#include "moduleEvent.h"
+#include "moduleProtocol.h"
+#include "moduleTime.h"
+#include "moduleUART.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleTelemetry.h
+ * @brief Binary telemetry frames sent over UART0 by DMA: sample batches and periodic snapshots.
+ *
+ * Telemetry is the consumer of `adc_ring`. Every filtered sample is collected, with its timestamp, zone
+ * and alarm level, into a batch (moduleBatch); a batch is sent as a `PROTOCOL_TYPE_BATCH` packet once it
+ * holds `telemetry_batch.size` samples or its first sample is `telemetry_batch_age_ms` old, whichever
+ * comes first. A small batch keeps latency low, a large one spends fewer bytes per sample on headers.
+ * Every `TELEMETRY_PERIOD_TICKS` SysTick periods a snapshot of the tracker and of the counters is sent
+ * as a `PROTOCOL_TYPE_SNAPSHOT` packet.
+ *
+ * Frames are built into one of two buffers and handed to the UART DMA channel; the CPU only builds them,
+ * the bytes reach the line without any per-byte interrupt. While a frame is waiting for the channel,
+ * samples stay in the batch and then in the ring, whose overruns are counted, and snapshots are skipped.
+ * Collection runs on every SysTick period and also whenever the ADC finds a whole batch waiting in the
+ * ring, so a batch goes out as soon as the channel frees instead of one frame per period.
+ *
+ * Sustainable rate: a 32-sample batch frame of a slowly moving distance takes about 78 bytes on the wire,
+ * about 2.5 bytes per sample, and the 100 ms snapshots about 310 bytes per second. The line carries a
+ * tenth of its bit rate in bytes, so the samples that can be sent without overruns are about:
+ *
+ * | Line rate  | Samples/s | Modes that fit at their default rate                   |
+ * |------------|-----------|--------------------------------------------------------|
+ * | 9600 bps   | 260       | Timer (1 Hz), match edge (250 Hz)                      |
+ * | 115200 bps | 4500      | The above and DMA block (3125 Hz)                      |
+ * | 230400 bps | 9000      | All, scan of a single channel (8000 Hz) included       |
+ *
+ * Text reports share the line and lower these figures. Above them the ring overflows whatever its size;
+ * lower the sample rate with the `rate` command, or raise the line rate with `baud` where the other end
+ * supports it.
+ */
+
+/**
+ * @defgroup Telemetry constants
+ * @brief Snapshot rate and batch limits.
+ *
+ */
+#ifndef TELEMETRY_PERIOD_TICKS
+#define TELEMETRY_PERIOD_TICKS 2 ///< SysTick periods between snapshots (100 ms), a third of the link at 9600 bps.
+#endif
+#ifndef TELEMETRY_MAX_PERIOD_MS
+#define TELEMETRY_MAX_PERIOD_MS 60000 ///< Longest period accepted by @ref telemetry_set_period.
+#endif
+#ifndef TELEMETRY_BATCH_SIZE
+#define TELEMETRY_BATCH_SIZE 32 ///< Samples per batch frame at reset, up to `BATCH_MAX_SAMPLES`.
+#endif
+#ifndef TELEMETRY_BATCH_AGE_MS
+#define TELEMETRY_BATCH_AGE_MS 200 ///< Age of the first sample that flushes a batch at reset.
+#endif
+#define TELEMETRY_FRAME_MAX PROTOCOL_FRAME_MAX ///< Size of a frame buffer, a batch can fill a whole packet.
+
+/**
+ * @brief Snapshots skipped because the previous frame was still waiting, saturates at 0xFFFF.
+ */
+extern volatile uint16_t telemetry_skipped;
+
+/**
+ * @brief SysTick periods between snapshots, 0 while they are stopped.
+ */
+extern volatile uint16_t telemetry_period;
+
+/**
+ * @brief Samples waiting for the next batch frames.
+ */
+extern batch_t telemetry_batch;
+
+/**
+ * @brief Age of the first sample of a batch that flushes it, in milliseconds.
+ */
+extern uint16_t telemetry_batch_age_ms;
+
+/**
+ * @brief Samples taken from `adc_ring` so far, wraps.
+ */
+extern uint32_t telemetry_samples;
+
+/**
+ * @brief Reset the sequence, the counters and the tick divider.
+ */
+void configure_telemetry(void);
+
+/**
+ * @brief Change the snapshot period.
+ *
+ * @param period_ms Period in milliseconds, rounded to SysTick periods (at least one); 0 stops the snapshots.
+ * @return 0 if applied, -1 if above `TELEMETRY_MAX_PERIOD_MS`.
+ */
+int telemetry_set_period(uint32_t period_ms);
+
+/**
+ * @brief Change the batch limits.
+ *
+ * @param size   Samples per batch frame, 1 to `BATCH_MAX_SAMPLES`.
+ * @param age_ms Age of the first sample that flushes a batch, in milliseconds, at most
+ *               `TELEMETRY_MAX_PERIOD_MS`.
+ * @return 0 if applied, -1 if out of range.
+ */
+int telemetry_set_batch(uint32_t size, uint32_t age_ms);
+
+/**
+ * @brief SysTick hook, counts the period and raises `EVENT_TELEMETRY`.
+ */
+void telemetry_tick(void);
+
+/**
+ * @brief Move the filtered samples from `adc_ring` into the batch, sending every batch that fills up.
+ *
+ * Runs in PendSV, from @ref telemetry_on_tick and from the reports that need an up to date sample count.
+ * Stops, leaving the samples in the ring, when a batch is full and the channel already has a frame
+ * waiting.
+ */
+void telemetry_collect(void);
+
+/**
+ * @brief Take a snapshot of the system state.
+ *
+ * @param snapshot Destination.
+ */
+void telemetry_capture(protocol_snapshot_t* snapshot);
+
+/**
+ * @brief Telemetry consumer of the periodic event.
+ *
+ * Collects the new samples and sends the batch if it is due by age, or right away when the system was just
+ * disabled. Every @ref telemetry_period SysTick periods it sends a snapshot; the events raised by the ADC for
+ * a waiting batch do not count as periods.
+ *
+ * @param events Raised events (EVENT_TELEMETRY, EVENT_ENABLE).
+ */
+void telemetry_on_tick(uint32_t events);
+
+#endif // MODULE_TELEMETRY_H
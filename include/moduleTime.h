@@ -0,0 +1,113 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleTime.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_TIME_H
+#define MODULE_TIME_H
+
+#include "LPC17xx.h"
+#include "lpc17xx_timer.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file moduleTime.h
+ * @brief Cycle-accurate time measurement.
+ *
+ * This module exposes the Cortex-M3 DWT cycle counter, used to timestamp events with CPU clock resolution,
+ * a free-running microsecond timer for timestamps that must stay comparable for longer, and a small
+ * accumulator to keep minimum, maximum and average of measured intervals.
+ */
+
+/**
+ * @defgroup Time module registers
+ * @brief DWT registers, not described by the CMSIS headers shipped with the project.
+ *
+ */
+#define DWT_CTRL           (*(volatile uint32_t*)0xE0001000UL) ///< DWT control register.
+#define DWT_CYCCNT         (*(volatile uint32_t*)0xE0001004UL) ///< DWT cycle counter.
+#define DWT_CTRL_CYCCNTENA ((uint32_t)(1 << 0))                ///< Cycle counter enable bit.
+
+#define TIMESTAMP_TIMER LPC_TIM2 ///< Free-running microsecond timer, wraps every ~71 minutes.
+
+/**
+ * @brief Minimum, maximum and sum of a series of intervals measured in CPU cycles.
+ */
+typedef struct
+{
+    uint32_t min;   ///< Shortest interval seen.
+    uint32_t max;   ///< Longest interval seen.
+    uint32_t last;  ///< Most recent interval.
+    uint32_t count; ///< Number of intervals accumulated.
+    uint64_t total; ///< Sum of all intervals, for the average.
+} cycle_stats_t;
+
+/**
+ * @brief Start the DWT cycle counter.
+ *
+ * Enables the trace block and the free-running 32-bit cycle counter. At 100 MHz it wraps every ~42 s,
+ * which is harmless as long as only differences shorter than that are measured.
+ */
+void configure_cycle_counter(void);
+
+/**
+ * @brief Read the cycle counter.
+ *
+ * @return Current value of the DWT cycle counter.
+ */
+static inline uint32_t cycle_count(void)
+{
+    return DWT_CYCCNT;
+}
+
+/**
+ * @brief Start the microsecond timestamp timer.
+ *
+ * TIMER2 counts microseconds from zero, without matches nor interrupts.
+ */
+void configure_timestamp_timer(void);
+
+/**
+ * @brief Read the microsecond timestamp.
+ *
+ * @return Microseconds since @ref configure_timestamp_timer, modulo 2^32.
+ */
+static inline uint32_t timestamp_us(void)
+{
+    return TIMESTAMP_TIMER->TC;
+}
+
+/**
+ * @brief Clear an interval accumulator.
+ *
+ * @param stats Accumulator to clear.
+ */
+void cycle_stats_reset(cycle_stats_t* stats);
+
+/**
+ * @brief Add one interval to an accumulator.
+ *
+ * @param stats  Accumulator to update.
+ * @param cycles Interval length in CPU cycles.
+ */
+void cycle_stats_add(cycle_stats_t* stats, uint32_t cycles);
+
+/**
+ * @brief Average interval of an accumulator.
+ *
+ * @param stats Accumulator to read.
+ * @return Average interval in CPU cycles, 0 if nothing has been accumulated.
+ */
+uint32_t cycle_stats_average(const cycle_stats_t* stats);
+
+#endif // MODULE_TIME_H
@@ -0,0 +1,97 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleTracker.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_TRACKER_H
+#define MODULE_TRACKER_H
+
+#include "moduleZone.h"
+#include <stdint.h>
+
+/**
+ * @file moduleTracker.h
+ * @brief Hardware-independent estimation of closing speed and time to collision.
+ *
+ * An alpha-beta filter follows the distance stream: each sample the position is predicted from the
+ * previous speed and both are corrected by a fraction of the prediction error. All the state is fixed
+ * point (Q8 millimetres and Q8 millimetres per second) and the gains are scaled once by the sample rate
+ * when the tracker is initialized, so an update is a few multiplies and shifts plus one hardware divide
+ * for the time to collision.
+ */
+
+/**
+ * @defgroup Tracker module constants
+ * @brief Filter gains and time to collision levels.
+ *
+ */
+#define TRACKER_Q           8     ///< Fractional bits of position and speed.
+#define TRACKER_GAIN_Q      16    ///< Fractional bits of the filter gains.
+#define TRACKER_DT_Q        24    ///< Fractional bits of the sample period in seconds.
+#define TRACKER_ALPHA       3277  ///< Position gain, 0.05 in Q16.
+#define TRACKER_BETA        84    ///< Speed gain, alpha^2 / (2 - alpha) in Q16 (critically damped).
+#define TRACKER_TTC_NONE    65535 ///< Time to collision reported when the obstacle is not getting nearer.
+#define TRACKER_MIN_CLOSING 20    ///< Closing speeds below this (mm/s) are treated as standing still.
+
+/**
+ * @brief Time to collision, in milliseconds, below which the alarm is raised to each zone.
+ *
+ * One value per zone, the row of `ZONE_CLEAR` is never used. Values must decrease from row to row.
+ */
+#ifndef TRACKER_TTC_TABLE
+#define TRACKER_TTC_TABLE {0, 3000, 1500, 700}
+#endif
+
+/**
+ * @brief State of an alpha-beta tracker.
+ */
+typedef struct
+{
+    int32_t position;       ///< Estimated distance, Q8 millimetres.
+    int32_t velocity;       ///< Estimated rate of change of the distance, Q8 mm/s (negative when closing).
+    int32_t dt;             ///< Sample period, Q24 seconds.
+    int32_t alpha;          ///< Position gain, Q16.
+    int32_t velocity_gain;  ///< Speed gain divided by the sample period (beta * rate), Q16 per second.
+    uint16_t closing_speed; ///< Speed at which the obstacle gets nearer, mm/s, 0 when it does not.
+    uint16_t ttc_ms;        ///< Time to collision in milliseconds, TRACKER_TTC_NONE when not closing.
+    uint8_t primed;         ///< FALSE until the first sample has set the position.
+} tracker_t;
+
+/**
+ * @brief Prepare a tracker for a distance stream.
+ *
+ * @param tracker Tracker to initialize.
+ * @param rate_hz Samples per second of the stream, at least 1.
+ * @param alpha   Position gain, Q16.
+ * @param beta    Speed gain, Q16.
+ */
+void tracker_init(tracker_t* tracker, uint32_t rate_hz, int32_t alpha, int32_t beta);
+
+/**
+ * @brief Feed one distance sample to the tracker.
+ *
+ * Updates position, speed, closing speed and time to collision.
+ *
+ * @param tracker  Tracker to update.
+ * @param distance Measured distance in millimetres.
+ */
+void tracker_update(tracker_t* tracker, uint16_t distance);
+
+/**
+ * @brief Alarm level demanded by the time to collision.
+ *
+ * @param tracker Tracker to evaluate.
+ * @return The nearest zone whose time to collision level has been crossed, `ZONE_CLEAR` if none.
+ */
+uint8_t tracker_urgency(const tracker_t* tracker);
+
+#endif // MODULE_TRACKER_H
@@ -15,12 +15,20 @@
 #ifndef MODULEUART_H
 #define MODULEUART_H
 
+#include "lpc17xx_clkpwr.h"
 #include "lpc17xx_uart.h"
+#include "moduleBaud.h"
+#include "moduleCommand.h"
+#include "moduleADC.h"
+#include "moduleDMA.h"
 #include "moduleEINT.h"
+#include "moduleEvent.h"
+#include "moduleFormat.h"
+#include "moduleProtocol.h"
+#include "moduleRing.h"
 #include "moduleSystick.h"
 #include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 #include <string.h>
 
 /**
@@ -35,25 +43,43 @@
  * @def COMMUNICATION_SPEED
  * @brief Defines the communication speed for UART.
  *
- * This macro sets the UART communication speed to 9600 baud.
+ * This macro sets the UART communication speed to 9600 baud at reset. It can be changed at run time with
+ * @ref uart_set_baud or by auto-baud detection.
  */
 #define COMMUNICATION_SPEED 9600
 
 /**
- * @def UART_BUFFER_SIZE
- * @brief Defines the size of the UART buffer.
+ * @def UART_AUTOBAUD_TIMEOUT_TICKS
+ * @brief SysTick periods the host has to send 'A' once auto-baud is armed (2 s).
+ */
+#define UART_AUTOBAUD_TIMEOUT_TICKS 40
+
+/**
+ * @defgroup UART auto-baud states
+ * @brief Steps of an auto-baud detection, in @ref uart_autobaud_state.
  *
- * This macro sets the size of the buffer used for UART communication to 10 characters.
  */
-#define UART_BUFFER_SIZE 10
+#define UART_AUTOBAUD_IDLE      0 ///< No detection running.
+#define UART_AUTOBAUD_REQUESTED 1 ///< Asked for, waiting for the transmitter to go idle.
+#define UART_AUTOBAUD_ARMED     2 ///< Hardware measuring the next 'A', transmission held.
+#define UART_AUTOBAUD_DONE      3 ///< Rate measured, waiting to be applied.
+#define UART_AUTOBAUD_EXPIRED   4 ///< No 'A' in time, the previous rate is restored.
 
 /**
- * @def DMA_SIZE
- * @brief Defines the DMA transfer size.
+ * @def UART_TX_RING_SIZE
+ * @brief Bytes of the UART0 transmit ring, a power of two.
  *
- * This macro specifies the number of samples to be transferred in each DMA operation.
+ * Room for several reports; at 9600 bps it takes about half a second to drain when full.
  */
-#define DMA_SIZE 60 /**< DMA transfer size in samples */
+#define UART_TX_RING_SIZE 512
+
+/**
+ * @def UART_RX_RING_SIZE
+ * @brief Bytes of the UART0 receive ring, a power of two.
+ *
+ * Commands are parsed in place as they arrive, the ring only has to cover the PendSV latency.
+ */
+#define UART_RX_RING_SIZE 64
 
 /**
  * @brief Holds the latest ADC conversion result.
@@ -64,57 +90,231 @@
  */
 extern volatile uint32_t adc_read_value;
 
+/**
+ * @brief Bytes waiting to be transmitted on UART0.
+ *
+ * Filled by @ref uart_write and drained by the UART DMA channel. `dropped` counts the bytes of the messages
+ * that did not fit.
+ */
+extern byte_ring_t uart_tx_ring;
+
+/**
+ * @brief GPDMA channel feeding the UART0 transmit FIFO, reserved by @ref conf_UART.
+ */
+extern uint8_t uart_dma_channel;
+
+/**
+ * @brief Bytes received on UART0, filled by @ref UART0_IRQHandler and parsed by @ref uart_on_command.
+ *
+ * `dropped` counts the bytes lost because the ring was full.
+ */
+extern byte_ring_t uart_rx_ring;
+
+/**
+ * @brief Parser of the received commands; its counters tell the valid and the invalid lines.
+ */
+extern command_parser_t uart_command_parser;
+
+/**
+ * @brief Line rate in use, in bits per second.
+ */
+extern volatile uint32_t uart_baud;
+
+/**
+ * @brief Step of the auto-baud detection, UART_AUTOBAUD_*.
+ */
+extern volatile uint8_t uart_autobaud_state;
+
 /**
  * @brief Configure the UART.
  *
- * Initialize the UART with default settings.
+ * Initialize the UART with default settings, with its transmit FIFO served by a GPDMA channel and its
+ * receive FIFO by the UART0 interrupt. @ref configure_dma must have been called before.
  */
 void conf_UART(void);
 
 /**
- * @brief Configures the DAC and UART for data transfer using DMA.
+ * @brief Program the UART0 divisors for a rate.
  *
- * This function initializes the DMA and sets up a linked list item (LLI)
- * for continuous data transfer from a memory table to the UART transmit register.
- * The DMA channel is configured for memory-to-peripheral transfer.
+ * Uses the divisor latch and fractional divider pair of @ref baud_divider, closer than the one of the
+ * driver and valid for the fractional divider (DLL >= 3). Only called while nothing is being sent.
+ * @param baud Rate in bits per second.
+ * @return 0 if programmed, -1 if the rate cannot be reached within `BAUD_MAX_ERROR_PPM`.
  */
-void configure_dac_uart(void);
+int uart_apply_baud(uint32_t baud);
 
 /**
- * @brief Sends the ADC value via UART.
+ * @brief Change the line rate at run time.
  *
- * @return Buffer with the information to be transmitted.
+ * The new rate is announced in a log packet at the current rate and applied as soon as that packet and
+ * everything queued before it has left the shift register.
+ * @param baud Rate in bits per second.
+ * @return 0 if the change was accepted, -1 if the rate cannot be reached within `BAUD_MAX_ERROR_PPM`.
  */
-uint32_t send_adc_value(void);
+int uart_set_baud(uint32_t baud);
 
 /**
- * @brief Send the status of the LEDs via UART.
+ * @brief Ask for auto-baud detection.
  *
- * Informs if the system is in reverse or normal mode.
- * @return Buffer with the information to be transmitted.
+ * Once the transmitter is idle, transmission is held and the hardware measures the next 'A' sent by the
+ * host; the measurement is snapped to the nearest standard rate. A break received on the line asks for it
+ * too. Without an 'A' within `UART_AUTOBAUD_TIMEOUT_TICKS` the previous rate is kept.
+ */
+void uart_autobaud(void);
+
+/**
+ * @brief SysTick hook of the line rate management; raises EVENT_BAUD while there is work to do.
+ */
+void uart_tick(void);
+
+/**
+ * @brief Line rate consumer, applies rate changes and runs the auto-baud steps.
+ *
+ * @param events Raised events (EVENT_BAUD).
+ */
+void uart_on_baud(uint32_t events);
+
+/**
+ * @brief Command consumer of the received bytes.
+ *
+ * Parses the bytes of @ref uart_rx_ring where they lie, runs every completed command and answers it with a
+ * log packet: `<verb>: ok`, `<verb>: rejected` when an argument is out of range, `?: invalid` for a line
+ * that is not a command. See moduleCommand for the syntax.
+ *
+ * @param events Raised events (EVENT_COMMAND).
+ */
+void uart_on_command(uint32_t events);
+
+/**
+ * @brief UART0 interrupt handler: received bytes, end of auto-baud and break detection.
  */
-uint32_t send_status_leds(void);
+void UART0_IRQHandler(void);
 
 /**
- * @brief Notify switch status via UART.
+ * @brief Queue a message for transmission on UART0 without waiting.
  *
- * Indicates whether the switch is enabled or disabled.
- * @return Buffer with the information to be transmitted.
+ * The message is copied into @ref uart_tx_ring and sent by the UART DMA channel, in runs of contiguous
+ * bytes. Messages are queued from a single context (the event handlers).
+ * @param data   Bytes to send.
+ * @param length Number of bytes.
+ * @return `length`, or 0 if the ring had no room and the message was dropped.
  */
-uint32_t notify_interruption_status(void);
+uint32_t uart_write(const uint8_t* data, uint32_t length);
 
 /**
- * @brief Sends the general status of the system via UART.
+ * @brief Hand a frame to the UART DMA channel without copying it.
  *
- * Provides information about the current operating mode.
- * @return Buffer with the information to be transmitted.
+ * The frame is sent as one transfer, before any text still in the ring. It must stay untouched until the
+ * next frame has been accepted, so callers alternate between two buffers and only build a new frame when
+ * @ref uart_frame_pending is false.
+ * @param frame  Bytes of the frame.
+ * @param length Number of bytes, at most 4095.
+ * @return 0 if the frame was queued, -1 if another frame is still waiting.
  */
-uint32_t send_system_status(void);
+int uart_send_frame(const uint8_t* frame, uint32_t length);
 
 /**
- * @brief Declaring array of function pointers for DMA transfer.
+ * @brief Whether a frame handed to @ref uart_send_frame is still waiting for the channel.
+ *
+ * @return 1 while waiting, 0 once its transfer has started.
+ */
+uint8_t uart_frame_pending(void);
+
+/**
+ * @brief Encode a packet, numbered and time stamped now.
+ *
+ * Every packet of the link, queued or handed as a frame, takes the next sequence number.
+ * @param type    PROTOCOL_TYPE_*.
+ * @param payload Payload bytes.
+ * @param length  Payload length, at most `PROTOCOL_MAX_PAYLOAD`.
+ * @param frame   Destination, at least `PROTOCOL_FRAME_SIZE(length)` bytes.
+ * @return Frame length, 0 if the payload is too long.
+ */
+size_t uart_encode_packet(uint8_t type, const uint8_t* payload, size_t length, uint8_t* frame);
+
+/**
+ * @brief Queue a packet for transmission on UART0 without waiting.
+ *
+ * @param type    PROTOCOL_TYPE_*.
+ * @param payload Payload bytes.
+ * @param length  Payload length, at most `PROTOCOL_MAX_PAYLOAD`.
+ * @return Bytes queued, 0 if the packet was dropped.
+ */
+uint32_t uart_send_packet(uint8_t type, const uint8_t* payload, size_t length);
+
+/**
+ * @brief Queue a text message as a `PROTOCOL_TYPE_LOG` packet.
+ *
+ * @param text NUL-terminated text; only the first `PROTOCOL_MAX_PAYLOAD` characters are sent.
+ * @return Bytes queued, 0 if the packet was dropped.
+ */
+uint32_t uart_send_text(const char* text);
+
+/**
+ * @brief Queue text of a known length as a `PROTOCOL_TYPE_LOG` packet.
+ *
+ * For text built with the moduleFormat conversions, which do not terminate it.
+ * @param text   Characters to send.
+ * @param length Number of characters; only the first `PROTOCOL_MAX_PAYLOAD` are sent.
+ * @return Bytes queued, 0 if the packet was dropped.
+ */
+uint32_t uart_send_log(const char* text, size_t length);
+
+/**
+ * @brief DMA callback of the UART channel.
+ *
+ * Releases the bytes just sent and starts the next frame or ring run.
+ * @param channel UART channel.
+ * @param status  `DMA_STATUS_DONE` and/or `DMA_STATUS_ERROR`.
+ */
+void uart_on_dma(uint8_t channel, uint32_t status);
+
+/**
+ * @brief Sends a binary status packet via UART.
+ *
+ * The samples gathered since the previous report are moved into the telemetry batch first; then the
+ * newest sample, zone, alarm level, tracker output and sample counters in one
+ * `PROTOCOL_TYPE_STATUS` packet.
+ * @return Number of bytes queued, 0 if the transmit ring was full.
+ */
+uint32_t send_status_packet(void);
+
+/**
+ * @brief Sends the sample-period jitter of the per-sample acquisition modes via UART.
+ *
+ * Reports, side by side, the shortest and longest period between conversion starts measured with the
+ * TIMER0 ISR starting conversions and with the MAT0.1 edge starting them in hardware. Sent on the `status`
+ * command.
+ * @return Number of bytes queued, 0 if the transmit ring was full.
+ */
+uint32_t send_jitter_report(void);
+
+/**
+ * @brief Sends the cost of the ADC interrupt via UART.
+ *
+ * Reports handler duration, conversion-start-to-handler latency and per-sample pipeline cost, so the
+ * minimal and the legacy (`ADC_ISR_LEGACY`) handlers can be compared on target. Sent on the `status` command.
+ * @return Number of bytes queued, 0 if the transmit ring was full.
+ */
+uint32_t send_isr_report(void);
+
+/**
+ * @brief Sends the cost of the tone mixer via UART.
+ *
+ * Reports the cycles spent rendering one DMA block of mixed voices, the blocks rendered and how many output
+ * samples had to be saturated. Sent on the `status` command.
+ * @return Number of bytes queued, 0 if the transmit ring was full.
+ */
+uint32_t send_mix_report(void);
+
+/**
+ * @brief Zone change consumer of the UART.
+ *
+ * Reports the samples gathered since the previous change, the new zone and the alarm level in one
+ * @ref send_status_packet.
  *
+ * @param events Raised events (EVENT_ZONE_CHANGE).
  */
-extern volatile uint32_t table_uart[4];
+void uart_on_zone_change(uint32_t events);
 
 #endif // MODULEUART_H
@@ -0,0 +1,99 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleZone.h
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef MODULE_ZONE_H
+#define MODULE_ZONE_H
+
+#include <stdint.h>
+
+/**
+ * @file moduleZone.h
+ * @brief Hardware-independent classification of sensor readings into proximity zones.
+ *
+ * Zones are numbered from the farthest (`ZONE_CLEAR`) to the nearest (`ZONE_DANGER`). Each zone above
+ * the first one has an enter level and a higher exit level: a reading must drop below `enter` to get
+ * into the zone and rise above `exit` to leave it, so noise around a single level cannot make the zone
+ * chatter. Readings are distances in millimetres, see moduleDistance.
+ */
+
+/**
+ * @defgroup Proximity zones
+ * @brief Zone indices, from far to near.
+ *
+ */
+#define ZONE_CLEAR   0 ///< Nothing in range.
+#define ZONE_CAUTION 1 ///< Obstacle far behind.
+#define ZONE_WARNING 2 ///< Obstacle close, the former reverse_flag = TRUE range.
+#define ZONE_DANGER  3 ///< Obstacle very close.
+#define ZONE_COUNT   4 ///< Number of zones, rows of ZONE_TABLE.
+
+/**
+ * @brief Enter/exit levels of every zone, in millimetres, one `{enter, exit}` pair per zone.
+ *
+ * Enter levels must decrease from row to row and each exit level must be above its enter level and below
+ * the enter level of the previous zone. The row of `ZONE_CLEAR` is never used, it cannot be entered
+ * from a farther zone nor left towards one.
+ */
+#ifndef ZONE_TABLE
+#define ZONE_TABLE {{0, 0}, {1900, 2000}, {1100, 1170}, {550, 600}}
+#endif
+
+/**
+ * @brief Hysteresis band of one zone.
+ */
+typedef struct
+{
+    uint16_t enter; ///< The zone is entered when the reading drops below this level.
+    uint16_t exit;  ///< The zone is left when the reading rises above this level.
+} zone_band_t;
+
+/// Band of every zone, built from ZONE_TABLE and changed with @ref zone_set_band.
+extern zone_band_t zone_table[ZONE_COUNT];
+
+/**
+ * @brief Compute the zone of a reading, given the zone of the previous one.
+ *
+ * Walks from the current zone towards the nearer or the farther ones only while the reading crosses their
+ * levels, so a reading that stays in its zone costs two comparisons and a jump of several zones costs
+ * one comparison per zone crossed.
+ *
+ * @param current Zone of the previous reading.
+ * @param value   New reading, in millimetres.
+ * @return Zone of the new reading.
+ */
+uint8_t zone_classify(uint8_t current, uint16_t value);
+
+/**
+ * @brief Change the band of one zone.
+ *
+ * The band is accepted only if the table keeps the ordering of `ZONE_TABLE`: `enter < exit`, the exit
+ * level below the enter level of the farther zone and the enter level above the exit level of the nearer
+ * one.
+ *
+ * @param zone  Zone index, `ZONE_CAUTION` to `ZONE_DANGER`.
+ * @param enter New enter level, in millimetres.
+ * @param exit  New exit level, in millimetres.
+ * @return 0 if the band was changed, -1 if it was rejected.
+ */
+int zone_set_band(uint8_t zone, uint16_t enter, uint16_t exit);
+
+/**
+ * @brief Short human readable name of a zone.
+ *
+ * @param zone Zone index.
+ * @return Name of the zone, "?" if the index is out of range.
+ */
+const char* zone_name(uint8_t zone);
+
+#endif // MODULE_ZONE_H
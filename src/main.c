@@ -35,10 +35,14 @@
 #include <string.h>
 
 #include "moduleADC.h"
+#include "moduleBuzzer.h"
 #include "moduleDAC.h"
 #include "moduleEINT.h"
+#include "moduleEvent.h"
 #include "modulePort.h"
 #include "moduleSystick.h"
+#include "moduleTelemetry.h"
+#include "moduleTime.h"
 #include "moduleUART.h"
 
 /**
@@ -47,13 +51,13 @@
  */
 int main(void)
 {
-    SystemInit(); /*!< Initialize the system clock */
+    SystemInit();                /*!< Initialize the system clock */
+    configure_cycle_counter();   /*!< Start the cycle counter used for timing measurements */
+    configure_timestamp_timer(); /*!< Start the microsecond timer used to timestamp samples */
 
     configure_port(); /*!< Configure the board pins */
 
-    configure_adc();             /*!< Configure the ADC */
-    configure_timer_and_match(); /*!< Configure Timer0 and its matches */
-    start_timer();               /*!< Start Timer0 */
+    configure_adc(); /*!< Configure the ADC */
 
     configure_systick();    /*!< Set the SysTick timer */
     SYSTICK_IntCmd(ENABLE); /*!< Enable SysTick interrupt */
@@ -62,17 +66,32 @@ int main(void)
     configure_external_interrupt(); /*!< Configure external interrupt */
     NVIC_EnableIRQ(EINT0_IRQn);     /*!< Enable interrupt EINT0 */
 
-    configure_dac();                           /*!< Set up the DAC */
-    configure_dma_for_dac(dac_value);          /*!< Configure the DMA for continuous wave output */
-    GPDMA_ChannelCmd(CHANNEL_DMA_DAC, ENABLE); /*!< Enable the DMA channel for the DAC */
+    configure_dma();    /*!< Reset the GPDMA once, before any channel is reserved */
+    configure_buzzer(); /*!< Alarm tone (DAC or PWM backend) and its beep cadence */
 
-    conf_UART();          /*!< Configure UART communication over DMA */
-    configure_dac_uart(); /*!< Configure DMA for UART */
+    conf_UART();           /*!< Configure UART communication over DMA */
+    configure_telemetry(); /*!< Periodic state frames, sent on the UART DMA channel */
 
     NVIC_SetPriority(EINT0_IRQn, 0);   /*!< Set priority for interrupt EINT0 */
     NVIC_SetPriority(TIMER0_IRQn, 1);  /*!< Set priority for Timer0 interrupt */
     NVIC_SetPriority(ADC_IRQn, 2);     /*!< Set priority for ADC interrupt */
+    NVIC_SetPriority(DMA_IRQn, 2);     /*!< Set priority for DMA interrupt (ADC blocks, DAC, UART) */
+    NVIC_SetPriority(TIMER1_IRQn, 3);  /*!< Set priority for Timer1 interrupt (beep cadence) */
     NVIC_SetPriority(SysTick_IRQn, 3); /*!< Set priority for SysTick interrupt */
+    NVIC_SetPriority(UART0_IRQn, 3);   /*!< Set priority for UART0 interrupt (commands, auto-baud) */
+
+    configure_events();                                                 /*!< Deferred notifications, lowest priority */
+    event_subscribe(EVENT_ADC_SAMPLES, adc_on_samples);                 /*!< Processing of the per-sample ADC modes */
+    event_subscribe(EVENT_ZONE_CHANGE, led_on_zone_change);             /*!< LED colour and blink period */
+    event_subscribe(EVENT_ZONE_CHANGE, buzzer_on_zone_change);          /*!< Alarm tone */
+    event_subscribe(EVENT_ENABLE, buzzer_on_enable);                    /*!< Fade the tone out or back in */
+    event_subscribe(EVENT_ZONE_CHANGE, uart_on_zone_change);            /*!< Status report */
+    event_subscribe(EVENT_TELEMETRY | EVENT_ENABLE, telemetry_on_tick); /*!< Telemetry frames, flushed on disable */
+    event_subscribe(EVENT_BAUD, uart_on_baud);                          /*!< Line rate changes and auto-baud */
+    event_subscribe(EVENT_COMMAND, uart_on_command);                    /*!< Received commands */
+    event_raise(EVENT_ZONE_CHANGE);                                     /*!< Apply the initial zone */
+
+    adc_start_acquisition(ADC_DEFAULT_MODE); /*!< Start sampling once every GPDMA user has been set up */
 
     /**
      * @brief Infinite loop.
@@ -14,61 +14,364 @@
  ****************************************************************************/
 
 #include "moduleADC.h"
+#include "moduleTelemetry.h"
 
-/// Last value read from ADC.
+/// Last filtered value, the one the system logic acts on.
 volatile uint32_t adc_read_value = 0;
 
+/// Last raw conversion, before the decimation filter.
+volatile uint32_t adc_raw_value = 0;
+
+/// Distance to the obstacle in millimetres, from `adc_read_value`.
+volatile uint16_t distance_mm = 0;
+
+/// Closing speed and time to collision estimated from `distance_mm`.
+tracker_t adc_tracker;
+
+/// Slots of the sample ring.
+static ring_sample_t adc_ring_slots[ADC_RING_SIZE];
+
+/// Every filtered sample with its timestamp, distance and zone, for a single consumer.
+sample_ring_t adc_ring = {0, 0, 0, ADC_RING_SIZE - 1, adc_ring_slots};
+
+/// Slots of the raw conversion ring.
+static ring_sample_t adc_raw_slots[ADC_RAW_RING];
+
+/// Raw conversions of the per-sample and scan modes, from the ADC ISR to the PendSV pipeline.
+sample_ring_t adc_raw_ring = {0, 0, 0, ADC_RAW_RING - 1, adc_raw_slots};
+
+/// CPU cycles spent in each ADC interrupt.
+cycle_stats_t adc_isr_stats;
+
+/// CPU cycles from the conversion start to the ADC interrupt entry.
+cycle_stats_t adc_latency_stats;
+
+/// CPU cycles spent per sample by the PendSV pipeline.
+cycle_stats_t adc_pipeline_stats;
+
+/// Decimation ratio of each acquisition mode, as log2; applied when the mode is started.
+uint8_t adc_decimation_log2[ADC_MODE_COUNT] = {ADC_TIMER_DECIM_LOG, ADC_DMA_DECIM_LOG, ADC_MATCH_DECIM_LOG,
+                                               ADC_SCAN_DECIM_LOG};
+
+/// Acquisition mode currently running.
+volatile uint8_t adc_acquisition_mode = ADC_MODE_TIMER_IRQ;
+
+/// Ping-pong sample blocks written by the GPDMA.
+volatile uint32_t adc_dma_block[2][ADC_BLOCK_SIZE];
+
+/// Number of GPDMA error interrupts seen on the ADC channel.
+volatile uint32_t adc_dma_errors = 0;
+
+/// State of every scanned channel.
+volatile adc_scan_t adc_scan;
+
+/// Period between consecutive conversion starts, for each per-sample acquisition mode.
+cycle_stats_t adc_period_stats[ADC_MODE_COUNT];
+
+/// Cycle counter value at the previous conversion start, 0 when there is none yet.
+static uint32_t adc_last_start = 0;
+
+/// Timestamp of the conversion being processed, recorded in the filtered sample ring.
+static uint32_t adc_sample_time = 0;
+
+/// CPU cycles per TIMER0 tick, used to turn the timer count back into cycles.
+static uint32_t adc_cycles_per_tick = 1;
+
+/// GPDMA channel of the ping-pong transfer, reserved on the first DMA acquisition.
+static uint8_t adc_dma_channel = DMA_NONE;
+
+/// Linked list items of the ping-pong transfer, two consecutive items of the DMA pool.
+static GPDMA_LLI_Type* adc_dma_lli = NULL;
+
+/// Index of the block the GPDMA is currently filling.
+static volatile uint8_t adc_dma_filling = 0;
+
+/// Scratch buffer with the unpacked 12-bit samples of the last finished block, decimated in place.
+static uint16_t adc_block_samples[ADC_BLOCK_SIZE];
+
+/// Oversampling filter between the conversions and the system logic.
+static signal_decimator_t adc_decimator;
+
 /**
  * @brief Set the timer and its match.
  *
- * This function initializes the TIMER0 timer with a 100 µs prescaler and sets the match register
- * to generate an interrupt every 60 seconds.
+ * - `ADC_MODE_TIMER_IRQ`: TIMER0 runs with a 100 µs prescaler and match 0 interrupts every second.
+ * - `ADC_MODE_MATCH_EDGE`: TIMER0 counts peripheral clock ticks and match 1 toggles the MAT0.1 output
+ *   twice per sample period; the ADC starts a conversion on each rising edge and no interrupt is raised.
  *
  */
-void configure_timer_and_match(void)
+void configure_timer_and_match(uint8_t mode)
 {
     TIM_TIMERCFG_Type timer_cfg_struct; /**< Structure to store timer settings. */
+    TIM_MATCHCFG_Type match_cfg_struct; /**< Structure to store match configuration. */
 
-    timer_cfg_struct.PrescaleOption = TIM_PRESCALE_USVAL; /**< Prescaler in microseconds. */
-    timer_cfg_struct.PrescaleValue = 100;                 /**< Prescaler value, time resolution ~100 µs. */
+    if (mode == ADC_MODE_MATCH_EDGE)
+    {
+        uint32_t timer_clock = CLKPWR_GetPCLK(CLKPWR_PCLKSEL_TIMER0);    /**< Timer input clock in Hz. */
+        uint32_t half_period = timer_clock / (2 * ADC_MATCH_SAMPLE_RATE); /**< Ticks between MAT0.1 toggles. */
 
-    TIM_Init(LPC_TIM0, TIM_TIMER_MODE, &timer_cfg_struct); /**< Initialize timer TIMER0. */
+        timer_cfg_struct.PrescaleOption = TIM_PRESCALE_TICKVAL; /**< Prescaler in peripheral clock ticks. */
+        timer_cfg_struct.PrescaleValue = 1;                     /**< Count every tick for the finest edge. */
 
-    TIM_MATCHCFG_Type match_cfg_struct; /**< Structure to store match configuration. */
+        match_cfg_struct.MatchChannel = ADC_MATCH_CHANNEL;         /**< MAT0.1 feeds the ADC start logic. */
+        match_cfg_struct.IntOnMatch = DISABLE;                     /**< The CPU is not involved. */
+        match_cfg_struct.StopOnMatch = DISABLE;                    /**< Does not stop timer on match. */
+        match_cfg_struct.ResetOnMatch = ENABLE;                    /**< Reset timer on match. */
+        match_cfg_struct.ExtMatchOutputType = TIM_EXTMATCH_TOGGLE; /**< One rising edge every two matches. */
+        match_cfg_struct.MatchValue = half_period - 1;             /**< Reset after half_period ticks. */
 
-    match_cfg_struct.MatchChannel = 0;                          /**< Matching channel 0. */
-    match_cfg_struct.IntOnMatch = ENABLE;                       /**< Enable break on match. */
-    match_cfg_struct.StopOnMatch = DISABLE;                     /**< Does not stop timer on match. */
-    match_cfg_struct.ResetOnMatch = ENABLE;                     /**< Reset timer on match. */
-    match_cfg_struct.ExtMatchOutputType = TIM_EXTMATCH_NOTHING; /**< No external match output. */
-    match_cfg_struct.MatchValue = (uint32_t)(SECOND);           /**< Match value for 1 second. */
+        adc_cycles_per_tick = SystemCoreClock / timer_clock;
+    }
+    else
+    {
+        timer_cfg_struct.PrescaleOption = TIM_PRESCALE_USVAL; /**< Prescaler in microseconds. */
+        timer_cfg_struct.PrescaleValue = 100;                 /**< Prescaler value, time resolution ~100 µs. */
+
+        match_cfg_struct.MatchChannel = 0;                          /**< Matching channel 0. */
+        match_cfg_struct.IntOnMatch = ENABLE;                       /**< Enable break on match. */
+        match_cfg_struct.StopOnMatch = DISABLE;                     /**< Does not stop timer on match. */
+        match_cfg_struct.ResetOnMatch = ENABLE;                     /**< Reset timer on match. */
+        match_cfg_struct.ExtMatchOutputType = TIM_EXTMATCH_NOTHING; /**< No external match output. */
+        match_cfg_struct.MatchValue = (uint32_t)(SECOND);           /**< Match value for 1 second. */
+    }
 
-    TIM_ConfigMatch(LPC_TIM0, &match_cfg_struct); /**< Set up the match. */
+    TIM_Init(LPC_TIM0, TIM_TIMER_MODE, &timer_cfg_struct); /**< Initialize timer TIMER0. */
+    TIM_ConfigMatch(LPC_TIM0, &match_cfg_struct);          /**< Set up the match. */
 }
 
 /**
  * @brief Start the timer.
  *
- * Activate timer TIMER0 and enable its interruption.
+ * Activate timer TIMER0 and, in the software triggered mode, enable its interruption.
  */
-void start_timer(void)
+void start_timer(uint8_t mode)
 {
-    TIM_Cmd(LPC_TIM0, ENABLE);   /**< Enable the timer. */
-    NVIC_EnableIRQ(TIMER0_IRQn); /**< Enable interrupt for TIMER0. */
+    TIM_Cmd(LPC_TIM0, ENABLE); /**< Enable the timer. */
+    if (mode == ADC_MODE_TIMER_IRQ)
+    {
+        NVIC_EnableIRQ(TIMER0_IRQn); /**< Enable interrupt for TIMER0. */
+    }
 }
 
 /**
  * @brief Set the ADC to perform periodic conversions.
  *
  * Initializes the ADC with a sample rate of 100 kHz and enables ADC channel 0 with interrupt.
+ * The NVIC line is left to @ref adc_start_acquisition, because the DMA mode needs it disabled.
  */
 void configure_adc(void)
 {
     ADC_Init(LPC_ADC, ADC_FREQ);                    /**< 100 kHz frequency. */
     ADC_ChannelCmd(LPC_ADC, ADC_CHANNEL_0, ENABLE); /**< Activate channel 0. */
     ADC_BurstCmd(LPC_ADC, DISABLE);                 /**< Disable burst mode. */
-    ADC_IntConfig(LPC_ADC, ADC_CHANNEL_0, ENABLE);  /**< Interruption on channel 0. */
-    NVIC_EnableIRQ(ADC_IRQn);                       /**< Enable ADC Interrupt. */
+    LPC_ADC->ADINTEN = ADC_INTEN_CH(ADC_CHANNEL_0); /**< Only channel 0 interrupts (or requests DMA). */
+}
+
+/**
+ * @brief Start acquiring samples in the given mode.
+ *
+ * - `ADC_MODE_TIMER_IRQ`: TIMER0 starts one conversion per match and the ADC ISR reads it.
+ * - `ADC_MODE_DMA_BLOCK`: the ADC converts continuously in burst mode at `ADC_FREQ` and the GPDMA moves
+ *   every result into the ping-pong blocks; the ADC interrupt stays disabled in the NVIC so the DONE flag
+ *   only raises DMA requests.
+ * - `ADC_MODE_MATCH_EDGE`: the rising edge of MAT0.1 starts each conversion and the ADC ISR reads it.
+ * - `ADC_MODE_SCAN`: the ADC converts the scanned channels round-robin in burst mode and interrupts once
+ *   per round.
+ *
+ * The period statistics of the new mode are cleared, the ones of the other modes are kept for comparison.
+ * The decimation filter restarts with the ratio of the new mode and the tracker with its output rate.
+ *
+ * The DMA interrupt is held off for the whole switch: otherwise a block completed just before the stop would
+ * be processed by @ref adc_on_dma in the middle of it, a second producer into `adc_ring` next to PendSV.
+ */
+void adc_start_acquisition(uint8_t mode)
+{
+    dma_irq_lock();
+    adc_stop_acquisition();
+    adc_on_samples(EVENT_ADC_SAMPLES); /**< Conversions still queued go through the path of their own mode. */
+    adc_acquisition_mode = mode;
+    adc_last_start = 0;
+    cycle_stats_reset(&adc_period_stats[mode]);
+    cycle_stats_reset(&adc_isr_stats);
+    cycle_stats_reset(&adc_latency_stats);
+    cycle_stats_reset(&adc_pipeline_stats);
+    signal_decimator_init(&adc_decimator, adc_decimation_log2[mode]);
+
+    if (mode == ADC_MODE_SCAN)
+    {
+        configure_adc_scan();
+        tracker_init(&adc_tracker, adc_output_rate(mode), TRACKER_ALPHA, TRACKER_BETA);
+        NVIC_EnableIRQ(ADC_IRQn);      /**< Enable ADC Interrupt. */
+        ADC_BurstCmd(LPC_ADC, ENABLE); /**< Scan continuously. */
+        dma_irq_unlock();
+        return;
+    }
+
+    configure_adc(); /**< Back to channel 0 at ADC_FREQ, in case a scan was running. */
+    tracker_init(&adc_tracker, adc_output_rate(mode), TRACKER_ALPHA, TRACKER_BETA);
+    if (mode == ADC_MODE_DMA_BLOCK)
+    {
+        configure_adc_dma();
+        ADC_BurstCmd(LPC_ADC, ENABLE); /**< Convert continuously, one DMA request per result. */
+    }
+    else
+    {
+        NVIC_EnableIRQ(ADC_IRQn); /**< Enable ADC Interrupt. */
+        configure_timer_and_match(mode);
+        if (mode == ADC_MODE_MATCH_EDGE)
+        {
+            ADC_EdgeStartConfig(LPC_ADC, ADC_START_ON_RISING); /**< Convert on the rising edge... */
+            ADC_StartCmd(LPC_ADC, ADC_START_ON_MAT01);         /**< ...of MAT0.1. */
+        }
+        start_timer(mode);
+    }
+    dma_irq_unlock();
+}
+
+/**
+ * @brief Stop the running acquisition.
+ *
+ * Leaves the ADC powered and configured, so a new mode can be started right away. A terminal count the DMA
+ * channel raised before being disabled is dropped with its block, it belongs to the stopped acquisition.
+ */
+void adc_stop_acquisition(void)
+{
+    TIM_Cmd(LPC_TIM0, DISABLE);                  /**< No more conversions started by TIMER0. */
+    NVIC_DisableIRQ(TIMER0_IRQn);                /**< Disable interrupt for TIMER0. */
+    ADC_BurstCmd(LPC_ADC, DISABLE);              /**< No more burst conversions. */
+    ADC_StartCmd(LPC_ADC, ADC_START_CONTINUOUS); /**< Clear the START field. */
+    NVIC_DisableIRQ(ADC_IRQn);                   /**< Disable ADC Interrupt. */
+    if (adc_dma_channel != DMA_NONE)
+    {
+        GPDMA_ChannelCmd(adc_dma_channel, DISABLE);                   /**< Stop the ping-pong transfer. */
+        GPDMA_ClearIntPending(GPDMA_STATCLR_INTTC, adc_dma_channel);  /**< No late block... */
+        GPDMA_ClearIntPending(GPDMA_STATCLR_INTERR, adc_dma_channel); /**< ...nor error. */
+    }
+}
+
+/**
+ * @brief Configure the ADC to scan every channel in `ADC_SCAN_CHANNELS` in burst mode.
+ *
+ * The converter is clocked for `ADC_SCAN_CONV_RATE` conversions per second, so a round over N channels
+ * takes N conversions and the interrupt rate is `ADC_SCAN_CONV_RATE / N`.
+ */
+void configure_adc_scan(void)
+{
+    uint8_t last = ADC_CHANNEL_0; /**< Highest selected channel, converted last in each round. */
+
+    adc_scan.count = 0;
+    for (uint8_t ch = 0; ch < ADC_MAX_CHANNELS; ch++)
+    {
+        if (ADC_SCAN_CHANNELS & (1 << ch))
+        {
+            adc_scan.channel[adc_scan.count] = ch;
+            adc_scan.filtered[adc_scan.count] = SIGNAL_RESULT_MASK; /**< Start far away. */
+            adc_scan.zone[adc_scan.count] = ZONE_CLEAR;
+            adc_scan.count++;
+            last = ch;
+        }
+    }
+
+    ADC_Init(LPC_ADC, ADC_SCAN_CONV_RATE); /**< Slower clock, one round every count conversions. */
+    for (uint8_t i = 0; i < adc_scan.count; i++)
+    {
+        ADC_ChannelCmd(LPC_ADC, adc_scan.channel[i], ENABLE); /**< Select every scanned channel. */
+    }
+    LPC_ADC->ADINTEN = ADC_INTEN_CH(last); /**< Only the end of the round interrupts. */
+}
+
+/**
+ * @brief Feed the conversion of one scanned channel to its slot.
+ *
+ * Smoothing, distance and zone are per slot. The last slot of the list closes the round: the nearest
+ * obstacle (lowest smoothed value over every slot) is published and goes through the common chain. A slot
+ * lost to a full raw ring only delays its own update, and a lost last slot skips that round.
+ */
+void adc_scan_process(uint8_t slot, uint16_t value)
+{
+    uint16_t nearest = SIGNAL_RESULT_MASK; /**< Lowest value of the round. */
+    int32_t filtered = adc_scan.filtered[slot];
+
+    filtered += ((int32_t)value - filtered) >> ADC_SCAN_FILTER_LOG;
+    adc_scan.value[slot] = value;
+    adc_scan.filtered[slot] = (uint16_t)filtered;
+    adc_scan.distance[slot] = distance_mm_from_counts((uint16_t)filtered);
+    adc_scan.zone[slot] = zone_classify(adc_scan.zone[slot], adc_scan.distance[slot]);
+
+    if (slot + 1 < adc_scan.count)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < adc_scan.count; i++)
+    {
+        nearest = (adc_scan.filtered[i] < nearest) ? adc_scan.filtered[i] : nearest;
+    }
+    adc_scan.scans++;
+    adc_read_value = nearest;
+    continue_reverse();
+}
+
+/**
+ * @brief Read the result of a complete scan.
+ *
+ * The data registers ADDR0..ADDR7 are consecutive, so each slot is read directly by channel number.
+ * Used by the legacy handler only, which processes the round inside the interrupt.
+ */
+void adc_scan_read(void)
+{
+    const volatile uint32_t* data = &LPC_ADC->ADDR0; /**< First channel data register. */
+
+    adc_sample_time = timestamp_us();
+    for (uint8_t i = 0; i < adc_scan.count; i++)
+    {
+        adc_scan_process(i, SIGNAL_RESULT(data[adc_scan.channel[i]]));
+    }
+}
+
+/**
+ * @brief Configure the GPDMA to move conversions into the ping-pong blocks.
+ *
+ * The channel starts writing block 0 and then follows the linked list items forever:
+ * block 1, block 0, block 1... Every item raises a terminal count interrupt when its block is full.
+ * The channel and its items are taken from the DMA service the first time and kept afterwards, so
+ * changing the acquisition mode never touches the DAC and UART channels.
+ */
+void configure_adc_dma(void)
+{
+    if (adc_dma_channel == DMA_NONE)
+    {
+        adc_dma_channel = dma_channel_reserve(DMA_PRIORITY_ADC, adc_on_dma);
+        adc_dma_lli = dma_lli_alloc(adc_dma_channel, 2);
+    }
+
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        adc_dma_lli[i].SrcAddr = (uint32_t) & (LPC_ADC->ADGDR); /**< Source: ADC global data register */
+        adc_dma_lli[i].DstAddr = (uint32_t)adc_dma_block[i];    /**< Destination: sample block i */
+        adc_dma_lli[i].NextLLI = (uint32_t)&adc_dma_lli[i ^ 1]; /**< Continue with the other block */
+        adc_dma_lli[i].Control = ADC_BLOCK_SIZE                 /**< Transfer size */
+                                 | GPDMA_DMACCxControl_SWidth(GPDMA_WIDTH_WORD) /**< Source width: 32 bits */
+                                 | GPDMA_DMACCxControl_DWidth(GPDMA_WIDTH_WORD) /**< Target width: 32 bits */
+                                 | GPDMA_DMACCxControl_DI                       /**< Increment destination */
+                                 | GPDMA_DMACCxControl_I; /**< Terminal count interrupt per block */
+    }
+
+    GPDMA_Channel_CFG_Type dma_config; /**< DMA channel configuration structure */
+
+    dma_config.ChannelNum = adc_dma_channel;            /**< Reserved ADC channel */
+    dma_config.TransferSize = ADC_BLOCK_SIZE;           /**< One block per transfer */
+    dma_config.TransferWidth = 0;                       /**< Not used */
+    dma_config.SrcMemAddr = 0;                          /**< Source is a peripheral (ADC) */
+    dma_config.DstMemAddr = (uint32_t)adc_dma_block[0]; /**< First block */
+    dma_config.TransferType = GPDMA_TRANSFERTYPE_P2M;   /**< Peripheral to memory transfer */
+    dma_config.SrcConn = GPDMA_CONN_ADC;                /**< Source: ADC connection */
+    dma_config.DstConn = 0;                             /**< Destination is memory */
+    dma_config.DMALLI = (uint32_t)&adc_dma_lli[1];      /**< After block 0 continue with block 1 */
+
+    adc_dma_filling = 0;
+    GPDMA_Setup(&dma_config);
+    GPDMA_ChannelCmd(adc_dma_channel, ENABLE);
 }
 
 /**
@@ -80,6 +383,7 @@ void configure_adc(void)
 void TIMER0_IRQHandler(void)
 {
     TIM_ClearIntPending(LPC_TIM0, TIM_MR0_INT); /**< Clear the interrupt flag. */
+    adc_record_sample_start(cycle_count());     /**< The conversion starts now, whenever "now" is. */
     ADC_StartCmd(LPC_ADC, ADC_START_NOW);       /**< Start ADC conversion. */
 }
 
@@ -87,30 +391,269 @@ void TIMER0_IRQHandler(void)
  * @brief Interrupt handler for the ADC.
  *
  * This function is executed when a conversion is completed in the ADC.
- * Reads the conversion value and calls the @ref continue_reverse function.
+ * In the hardware triggered mode TIMER0 was reset by the match that started the conversion, so its count
+ * tells how long ago that happened and the exact start instant can be recovered.
+ *
+ * The minimal handler reads ADDR0 once, which also clears the interrupt, queues the result and leaves the
+ * processing to PendSV; in scan mode it reads each scanned channel once, one raw ring entry per channel.
+ * It never masks its own line: the NVIC does not re-enter a handler that is already active, and the ring
+ * is only written from here. A conversion that finds the ring full is counted in its overruns. The legacy
+ * handler (`ADC_ISR_LEGACY`) is kept for comparison, and `adc-isr-bench` splits the work of both on the
+ * host.
  */
 void ADC_IRQHandler(void)
 {
-    NVIC_DisableIRQ(ADC_IRQn);                                   /**< Temporarily disables ADC interrupt. */
-    adc_read_value = ADC_ChannelGetData(LPC_ADC, ADC_CHANNEL_0); /**< Read the ADC conversion value. */
-    continue_reverse();       /**< Control the reverse flag depending on the adc value */
+    uint32_t entry = cycle_count(); /**< Interrupt entry, for the latency and the handler duration. */
+
+    if (adc_acquisition_mode == ADC_MODE_MATCH_EDGE)
+    {
+        uint32_t start = entry - LPC_TIM0->TC * adc_cycles_per_tick; /**< Instant of the MAT0.1 edge. */
+        adc_record_sample_start(start);
+        cycle_stats_add(&adc_latency_stats, entry - start);
+    }
+    else if (adc_acquisition_mode == ADC_MODE_TIMER_IRQ && adc_last_start != 0)
+    {
+        cycle_stats_add(&adc_latency_stats, entry - adc_last_start); /**< Started by the TIMER0 ISR. */
+    }
+
+#if ADC_ISR_LEGACY
+    NVIC_DisableIRQ(ADC_IRQn); /**< Temporarily disables ADC interrupt. */
+    if (adc_acquisition_mode == ADC_MODE_SCAN)
+    {
+        adc_scan_read(); /**< Every scanned channel at once. */
+    }
+    else
+    {
+        adc_sample_time = timestamp_us();
+        adc_process_sample(ADC_ChannelGetData(LPC_ADC, ADC_CHANNEL_0)); /**< Read the ADC conversion value. */
+    }
     NVIC_EnableIRQ(ADC_IRQn); /**< Enable ADC interrupt again. */
+#else
+    ring_sample_t sample = {0};
+
+    if (adc_acquisition_mode == ADC_MODE_SCAN)
+    {
+        const volatile uint32_t* data = &LPC_ADC->ADDR0; /**< First channel data register. */
+
+        sample.timestamp = timestamp_us();
+        for (uint8_t i = 0; i < adc_scan.count; i++)
+        {
+            sample.value = SIGNAL_RESULT(data[adc_scan.channel[i]]); /**< Single read of each channel. */
+            sample.zone = i;                                         /**< Slot, see adc_on_samples. */
+            ring_push(&adc_raw_ring, &sample);
+        }
+    }
+    else
+    {
+        sample.value = SIGNAL_RESULT(LPC_ADC->ADDR0); /**< Single read, clears DONE and the interrupt. */
+        sample.timestamp = timestamp_us();
+        ring_push(&adc_raw_ring, &sample);
+    }
+    event_raise(EVENT_ADC_SAMPLES);
+#endif
+
+    cycle_stats_add(&adc_isr_stats, cycle_count() - entry);
 }
 
 /**
- * @brief Control the reverse flag depending on the adc value.
+ * @brief PendSV side of the per-sample and scan modes.
  *
- * This function evaluates the value of `adc_read_value` and adjusts
- * `reverse_flag` based on whether it meets the allowed limits.
+ * Conversions are taken in batches; each one goes through the filter and, when the filter produces a
+ * value, through distance, zone and tracker. In scan mode an entry is one channel of a round, its slot in
+ * the `zone` field, and goes to the smoothing of that slot instead.
+ */
+void adc_on_samples(uint32_t events)
+{
+    ring_sample_t batch[ADC_RAW_RING / 4]; /**< Small batches keep the stack use low. */
+    size_t count;
+
+    (void)events;
+    while ((count = ring_pop_batch(&adc_raw_ring, batch, ADC_RAW_RING / 4)) > 0)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t start = cycle_count();
+            adc_sample_time = batch[i].timestamp; /**< When it was converted, not when it is processed. */
+            if (adc_acquisition_mode == ADC_MODE_SCAN)
+            {
+                adc_scan_process(batch[i].zone, batch[i].value);
+            }
+            else
+            {
+                adc_process_sample(batch[i].value);
+            }
+            cycle_stats_add(&adc_pipeline_stats, cycle_count() - start);
+        }
+    }
+}
+
+/**
+ * @brief GPDMA callback of the ADC channel.
+ *
+ * A terminal count means the block being filled is complete; the GPDMA has already moved on to the other
+ * block, so the finished one can be processed here without copying it.
+ */
+void adc_on_dma(uint8_t channel, uint32_t status)
+{
+    (void)channel;
+    if (status & DMA_STATUS_DONE)
+    {
+        uint8_t finished = adc_dma_filling; /**< Block that has just been completed. */
+        adc_dma_filling = finished ^ 1;
+        adc_process_block(adc_dma_block[finished], ADC_BLOCK_SIZE);
+    }
+
+    if (status & DMA_STATUS_ERROR)
+    {
+        adc_dma_errors++;
+    }
+}
+
+/**
+ * @brief Process one block of raw conversions.
+ *
+ * The block is unpacked and decimated in place with the hardware-independent functions of moduleSignal;
+ * every decimated value takes the place of a single conversion in the rest of the system. Each value is
+ * time stamped with the conversion that closed its window, counted back from the end of the block at the
+ * conversion period, so the values of one block do not share a timestamp.
+ */
+void adc_process_block(const volatile uint32_t* block, size_t count)
+{
+    const uint32_t end = timestamp_us(); /**< Time of the last conversion of the block. */
+    const size_t ratio = (size_t)1 << adc_decimator.log2_ratio;
+    size_t closed = ratio - adc_decimator.fill - 1; /**< Index of the conversion closing the first window. */
+    size_t produced;                                /**< Decimated values left at the start of the scratch buffer. */
+
+    signal_unpack_block(block, adc_block_samples, count);
+    adc_raw_value = adc_block_samples[count - 1];
+    produced = signal_decimate_block(&adc_decimator, adc_block_samples, count, adc_block_samples);
+
+    for (size_t i = 0; i < produced; i++, closed += ratio)
+    {
+        adc_sample_time = end - (uint32_t)((count - 1 - closed) * 1000000u / ADC_FREQ);
+        adc_read_value = adc_block_samples[i];
+        continue_reverse();
+    }
+}
+
+/**
+ * @brief Feed one conversion of the per-sample modes to the decimation filter.
+ */
+void adc_process_sample(uint16_t value)
+{
+    uint16_t filtered; /**< Output of the filter, valid once per window. */
+
+    adc_raw_value = value;
+    if (signal_decimate(&adc_decimator, value, &filtered))
+    {
+        adc_read_value = filtered;
+        continue_reverse();
+    }
+}
+
+/**
+ * @brief Update the distance and the proximity zone from the ADC value.
+ *
+ * This function converts `adc_read_value` into millimetres, classifies the distance with the zone
+ * table and tracks it to estimate the time to collision. The LEDs, the DAC and the UART are notified
+ * through an event only when the zone or the alarm level changes. The sample goes into `adc_ring`, and
+ * telemetry is woken once the ring holds a whole batch, so at the fast modes the ring is drained at the
+ * rate it fills instead of once per SysTick period.
  */
 void continue_reverse(void)
 {
-    if (adc_read_value < MAX_VALUE_ALLOWED)
+    uint8_t zone;    /**< Zone of the new distance. */
+    uint8_t urgency; /**< Level demanded by the time to collision. */
+    uint8_t level;   /**< Resulting alarm level. */
+    ring_sample_t sample;
+
+    distance_mm = distance_mm_from_counts((uint16_t)adc_read_value);
+    zone = zone_classify(proximity_zone, distance_mm);
+
+    tracker_update(&adc_tracker, distance_mm);
+    urgency = tracker_urgency(&adc_tracker);
+    level = (urgency > zone) ? urgency : zone;
+
+    if (zone != proximity_zone || level != alarm_level)
     {
-        reverse_flag = TRUE;
+        proximity_zone = zone;
+        alarm_level = level;
+        event_raise(EVENT_ZONE_CHANGE); /**< Software analog watchdog: only transitions wake the consumers. */
     }
-    else
+
+    sample.timestamp = adc_sample_time;
+    sample.value = (uint16_t)adc_read_value;
+    sample.distance = distance_mm;
+    sample.zone = zone;
+    sample.level = level;
+    ring_push(&adc_ring, &sample); /**< A full ring counts the overrun and drops the sample. */
+    if (ring_count(&adc_ring) >= telemetry_batch.size)
+    {
+        event_raise(EVENT_TELEMETRY); /**< A whole batch is waiting, collect it without waiting for SysTick. */
+    }
+}
+
+/**
+ * @brief Record the instant a conversion was started.
+ *
+ * The first start after a mode change only sets the reference.
+ */
+void adc_record_sample_start(uint32_t cycles)
+{
+    if (adc_last_start != 0)
     {
-        reverse_flag = FALSE;
+        cycle_stats_add(&adc_period_stats[adc_acquisition_mode], cycles - adc_last_start);
     }
-}
\ No newline at end of file
+    adc_last_start = cycles;
+}
+
+/**
+ * @brief Conversions per second of a mode, before decimation.
+ *
+ * In scan mode the conversion rate is shared by the scanned channels, so @ref configure_adc_scan must have
+ * run before.
+ */
+static uint32_t adc_input_rate(uint8_t mode)
+{
+    switch (mode)
+    {
+    case ADC_MODE_DMA_BLOCK:
+        return ADC_FREQ;
+    case ADC_MODE_MATCH_EDGE:
+        return ADC_MATCH_SAMPLE_RATE;
+    case ADC_MODE_SCAN:
+        return ADC_SCAN_CONV_RATE / ((adc_scan.count > 0) ? adc_scan.count : 1);
+    default:
+        return 1; /**< One TIMER0 match per second. */
+    }
+}
+
+/**
+ * @brief Rate at which the running mode delivers filtered values.
+ */
+uint32_t adc_output_rate(uint8_t mode)
+{
+    uint32_t rate = adc_input_rate(mode) >> adc_decimation_log2[mode];
+    return (rate > 0) ? rate : 1;
+}
+
+/**
+ * @brief Change the filtered sample rate of the running mode.
+ *
+ * Picks the largest decimation ratio whose output rate is still at least `rate`, and restarts the
+ * acquisition so the filter and the tracker take it.
+ */
+uint32_t adc_set_output_rate(uint32_t rate)
+{
+    uint8_t mode = adc_acquisition_mode;
+    uint32_t input = adc_input_rate(mode);
+    uint8_t log2_ratio = 0;
+
+    while (log2_ratio < SIGNAL_MAX_LOG2 && (input >> (log2_ratio + 1)) >= rate)
+    {
+        log2_ratio++;
+    }
+    adc_decimation_log2[mode] = log2_ratio;
+    adc_start_acquisition(mode);
+    return adc_output_rate(mode);
+}
@@ -0,0 +1,287 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleBatch.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleBatch.h"
+
+#include <string.h>
+
+/**
+ * @file moduleBatch.c
+ * @brief Implementation of the sample batches and of their frames.
+ */
+
+#define MAX_INTERVAL 0xFFFEu ///< Largest interval in offset units, one below the codec limit for rounding.
+
+/**
+ * @brief Clamp a batch size to 1..`BATCH_MAX_SAMPLES`.
+ */
+static uint8_t batch_clamp(uint8_t size)
+{
+    if (size == 0)
+    {
+        return 1;
+    }
+    return (size > BATCH_MAX_SAMPLES) ? BATCH_MAX_SAMPLES : size;
+}
+
+static void put_u32(uint8_t* out, uint32_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_u32(const uint8_t* in)
+{
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+/**
+ * @brief Empty a batch and set its size.
+ */
+void batch_init(batch_t* batch, uint8_t size)
+{
+    batch->count = 0;
+    batch->size = batch_clamp(size);
+}
+
+/**
+ * @brief Change the size of a batch, keeping its samples.
+ */
+void batch_resize(batch_t* batch, uint8_t size)
+{
+    batch->size = batch_clamp(size);
+}
+
+/**
+ * @brief Add a sample.
+ */
+int batch_add(batch_t* batch, uint32_t timestamp, uint16_t value, uint8_t state)
+{
+    if (batch->count >= BATCH_MAX_SAMPLES)
+    {
+        return -1;
+    }
+
+    batch->times[batch->count] = timestamp;
+    batch->values[batch->count] = value;
+    batch->states[batch->count] = state;
+    batch->count++;
+    return batch->count >= batch->size;
+}
+
+/**
+ * @brief Time since the first sample of a batch.
+ */
+uint32_t batch_age(const batch_t* batch, uint32_t now)
+{
+    return (batch->count > 0) ? now - batch->times[0] : 0;
+}
+
+/**
+ * @brief Encode the first `count` samples of a batch.
+ *
+ * Each codec block goes through a scratch buffer first, so nothing is written past `room`.
+ *
+ * @return Payload length, 0 if the samples do not fit.
+ */
+static size_t batch_encode(const batch_t* batch, uint8_t count, const batch_counters_t* counters, uint8_t* out,
+                           size_t room)
+{
+    uint8_t scratch[CODEC_BLOCK_MAX(BATCH_MAX_SAMPLES)];
+    uint16_t intervals[BATCH_MAX_SAMPLES];
+    uint32_t longest = 0;
+    uint8_t shift = 0;
+    uint8_t changes = 0;
+    size_t length = BATCH_HEADER_SIZE;
+    size_t block;
+
+    for (uint8_t i = 1; i < count; i++)
+    {
+        uint32_t interval = batch->times[i] - batch->times[i - 1];
+        longest = (interval > longest) ? interval : longest;
+    }
+    while ((longest >> shift) >= MAX_INTERVAL)
+    {
+        shift++; /**< Only slow modes, e.g. one sample per second, need a coarser unit. */
+    }
+
+    put_u32(&out[0], batch->times[0]);
+    out[4] = counters->flags;
+    put_u32(&out[5], counters->adc_overruns);
+    put_u32(&out[9], counters->uart_dropped);
+    out[13] = shift;
+    out[14] = batch->states[0];
+
+    for (uint8_t i = 1; i < count; i++)
+    {
+        if (batch->states[i] == batch->states[i - 1])
+        {
+            continue;
+        }
+        if (length + 2 > room)
+        {
+            return 0;
+        }
+        out[length++] = i;
+        out[length++] = batch->states[i];
+        changes++;
+    }
+    out[15] = changes;
+
+    block = codec_encode_block(batch->values, count, scratch);
+    if (length + block > room)
+    {
+        return 0;
+    }
+    memcpy(&out[length], scratch, block);
+    length += block;
+
+    intervals[0] = 0;
+    for (uint8_t i = 1; i < count; i++)
+    {
+        uint32_t previous = (batch->times[i - 1] - batch->times[0]) >> shift;
+        uint32_t current = (batch->times[i] - batch->times[0]) >> shift;
+        intervals[i] = (uint16_t)(current - previous); /**< Offsets are rounded, not the intervals: no drift. */
+    }
+    block = codec_encode_block(intervals, count, scratch);
+    if (length + block > room)
+    {
+        return 0;
+    }
+    memcpy(&out[length], scratch, block);
+    return length + block;
+}
+
+/**
+ * @brief Encode the oldest samples of a batch into a frame payload and remove them.
+ *
+ * The whole batch is tried first; if it does not fit, a quarter fewer samples each time. A single sample
+ * always fits in `BATCH_MIN_PAYLOAD`.
+ */
+size_t batch_pack(batch_t* batch, const batch_counters_t* counters, uint8_t* out, size_t room)
+{
+    uint8_t count = batch->count;
+    size_t length;
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    while ((length = batch_encode(batch, count, counters, out, room)) == 0 && count > 1)
+    {
+        count -= (uint8_t)((count + 3) / 4);
+    }
+
+    batch->count -= count;
+    memmove(batch->times, &batch->times[count], batch->count * sizeof(batch->times[0]));
+    memmove(batch->values, &batch->values[count], batch->count * sizeof(batch->values[0]));
+    memmove(batch->states, &batch->states[count], batch->count * sizeof(batch->states[0]));
+    return length;
+}
+
+/**
+ * @brief Decode one codec block of a payload.
+ *
+ * @return Bytes used, 0 if the block is malformed, empty, longer than `BATCH_MAX_SAMPLES` or runs past the
+ *         payload.
+ */
+static size_t batch_decode_block(const uint8_t* in, size_t length, uint16_t* out, uint8_t* count)
+{
+    codec_decoder_t decoder;
+    uint16_t decoded[2];
+    size_t produced = 0;
+
+    codec_decoder_init(&decoder);
+    for (size_t i = 0; i < length; i++)
+    {
+        size_t fresh = codec_decoder_feed(&decoder, in[i], decoded);
+        if (decoder.errors > 0 || produced + fresh > BATCH_MAX_SAMPLES)
+        {
+            return 0;
+        }
+        for (size_t k = 0; k < fresh; k++)
+        {
+            out[produced++] = decoded[k];
+        }
+        if (decoder.blocks == 1)
+        {
+            *count = (uint8_t)produced;
+            return (produced > 0) ? i + 1 : 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Decode a frame payload.
+ *
+ * Offsets are rebuilt as running sums of the intervals, then scaled to microseconds.
+ */
+int batch_unpack(const uint8_t* payload, size_t length, batch_frame_t* frame)
+{
+    uint16_t intervals[BATCH_MAX_SAMPLES];
+    const uint8_t* changes = &payload[BATCH_HEADER_SIZE];
+    size_t position = BATCH_HEADER_SIZE;
+    uint8_t intervals_count;
+    uint8_t change = 0;
+    uint32_t offset = 0;
+    uint8_t shift;
+    uint8_t state;
+    size_t used;
+
+    if (length < BATCH_HEADER_SIZE)
+    {
+        return -1;
+    }
+    frame->base = get_u32(&payload[0]);
+    frame->counters.flags = payload[4];
+    frame->counters.adc_overruns = get_u32(&payload[5]);
+    frame->counters.uart_dropped = get_u32(&payload[9]);
+    shift = payload[13];
+    state = payload[14];
+    frame->changes = payload[15];
+    position += 2 * (size_t)frame->changes;
+    if (shift > 31 || position > length)
+    {
+        return -1;
+    }
+
+    used = batch_decode_block(&payload[position], length - position, frame->values, &frame->count);
+    if (used == 0)
+    {
+        return -1;
+    }
+    position += used;
+    used = batch_decode_block(&payload[position], length - position, intervals, &intervals_count);
+    if (used == 0 || position + used != length || intervals_count != frame->count)
+    {
+        return -1;
+    }
+
+    for (uint8_t i = 0; i < frame->count; i++)
+    {
+        if (change < frame->changes && changes[2 * change] == i)
+        {
+            state = changes[2 * change + 1];
+            change++;
+        }
+        offset += intervals[i];
+        frame->offsets[i] = offset << shift;
+        frame->states[i] = state;
+    }
+    return (change == frame->changes) ? 0 : -1; /**< Changes out of order or past the last sample. */
+}
@@ -0,0 +1,115 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleBaud.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleBaud.h"
+
+/**
+ * @file moduleBaud.c
+ * @brief Implementation of the UART baud rate divider calculation.
+ */
+
+/// Rates the host can ask for.
+static const uint32_t baud_standard_rates[BAUD_STANDARD_COUNT] = BAUD_STANDARD_RATES;
+
+/**
+ * @brief Find the divider settings closest to a rate.
+ *
+ * For every fraction the divisor is rounded to the nearest integer, so at most 120 candidates are
+ * evaluated, in 64-bit integer arithmetic. The fractions are tried from MULVAL 1 (fractional divider off)
+ * up, and only a strictly better candidate replaces the current one, so an exact plain divisor wins.
+ */
+int baud_divider(uint32_t pclk, uint32_t baud, baud_divider_t* divider)
+{
+    uint64_t best_error = UINT64_MAX;
+
+    divider->divisor = 0;
+    if (baud == 0)
+    {
+        return -1;
+    }
+
+    for (uint8_t mul = 1; mul <= 15; mul++)
+    {
+        for (uint8_t add = 0; add < mul; add++)
+        {
+            uint64_t den = 16ull * baud * (mul + add);
+            uint64_t dl = ((uint64_t)pclk * mul + den / 2) / den;
+            uint64_t actual;
+            uint64_t error;
+
+            if (dl == 0 || dl > 0xFFFF || (add > 0 && dl < BAUD_MIN_FRACTIONAL_DL))
+            {
+                continue;
+            }
+
+            actual = ((uint64_t)pclk * mul) / (16 * dl * (mul + add));
+            error = (actual > baud) ? actual - baud : baud - actual;
+            if (error < best_error)
+            {
+                best_error = error;
+                divider->divisor = (uint16_t)dl;
+                divider->mulval = mul;
+                divider->divaddval = add;
+                divider->actual = (uint32_t)actual;
+            }
+        }
+    }
+
+    if (divider->divisor == 0)
+    {
+        return -1;
+    }
+
+    divider->error_ppm = (int32_t)(((int64_t)divider->actual - (int64_t)baud) * 1000000 / (int64_t)baud);
+    return (best_error * 1000000 <= (uint64_t)baud * BAUD_MAX_ERROR_PPM) ? 0 : -1;
+}
+
+/**
+ * @brief Standard rate closest to a measured one.
+ *
+ * Neighbouring rates are at least 1.5 times apart, so comparing the ratios by cross multiplication picks
+ * the right one even when the measurement is off by several percent.
+ */
+uint32_t baud_snap(uint32_t measured)
+{
+    uint32_t best = baud_standard_rates[0];
+
+    for (uint8_t i = 1; i < BAUD_STANDARD_COUNT; i++)
+    {
+        uint32_t lower = baud_standard_rates[i - 1];
+        uint32_t upper = baud_standard_rates[i];
+
+        /* measured / lower > upper / measured: closer to the upper rate on a logarithmic scale. */
+        if ((uint64_t)measured * measured > (uint64_t)lower * upper)
+        {
+            best = upper;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Whether a rate is one of `BAUD_STANDARD_RATES`.
+ */
+int baud_is_standard(uint32_t baud)
+{
+    for (uint8_t i = 0; i < BAUD_STANDARD_COUNT; i++)
+    {
+        if (baud_standard_rates[i] == baud)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,298 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleBuzzer.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleBuzzer.h"
+#include "moduleADC.h"
+
+/**
+ * @file moduleBuzzer.c
+ * @brief Implementation of the beep cadence and of both tone backends.
+ */
+
+/// Alarm level whose tone is played during the beeps.
+static volatile uint8_t buzzer_level = ZONE_CLEAR;
+
+/// TRUE during a beep, FALSE during the silence between beeps.
+static volatile uint8_t buzzer_gate_open = TRUE;
+
+#if BUZZER_BACKEND == BUZZER_BACKEND_PWM
+
+/**
+ * @brief Start PWM1 with the output low.
+ *
+ * MR0 sets the period and resets the counter, MR1 ends the high half (PWM1.1 is always single edge); both
+ * are latched and only take effect at the next period, so a change of tone never cuts a period short.
+ */
+static void buzzer_backend_init(void)
+{
+    PWM_TIMERCFG_Type pwm_cfg_struct;   /**< Structure to store PWM timer settings. */
+    PWM_MATCHCFG_Type match_cfg_struct; /**< Structure to store match configuration. */
+
+    pwm_cfg_struct.PrescaleOption = PWM_TIMER_PRESCALE_TICKVAL; /**< Prescaler in peripheral clock ticks. */
+    pwm_cfg_struct.PrescaleValue = 1;                           /**< Count every tick, finest frequency step. */
+    PWM_Init(LPC_PWM1, PWM_MODE_TIMER, &pwm_cfg_struct);        /**< Power PWM1, PCLK = CCLK / 4. */
+
+    match_cfg_struct.MatchChannel = 0;      /**< MR0: period. */
+    match_cfg_struct.IntOnMatch = DISABLE;  /**< The CPU is not involved. */
+    match_cfg_struct.StopOnMatch = DISABLE; /**< Does not stop on match. */
+    match_cfg_struct.ResetOnMatch = ENABLE; /**< Reset on match, one period per MR0. */
+    PWM_ConfigMatch(LPC_PWM1, &match_cfg_struct);
+
+    match_cfg_struct.MatchChannel = BUZZER_PWM_CHANNEL; /**< MR1: end of the high half. */
+    match_cfg_struct.ResetOnMatch = DISABLE;            /**< Only MR0 resets the counter. */
+    PWM_ConfigMatch(LPC_PWM1, &match_cfg_struct);
+
+    PWM_MatchUpdate(LPC_PWM1, 0, 1, PWM_MATCH_UPDATE_NOW); /**< Any period, the output stays low. */
+    PWM_MatchUpdate(LPC_PWM1, BUZZER_PWM_CHANNEL, 0, PWM_MATCH_UPDATE_NOW);
+
+    PWM_ChannelCmd(LPC_PWM1, BUZZER_PWM_CHANNEL, ENABLE);
+    PWM_ResetCounter(LPC_PWM1);
+    PWM_CounterCmd(LPC_PWM1, ENABLE);
+    PWM_Cmd(LPC_PWM1, ENABLE);
+}
+
+/**
+ * @brief Play the tone of a level, or nothing for the silent level.
+ *
+ * A match value of 0 keeps the output low for the whole period.
+ */
+static void buzzer_backend_play(uint8_t level)
+{
+    uint32_t frequency = buzzer_frequency(level);
+
+    if (frequency == 0)
+    {
+        PWM_MatchUpdate(LPC_PWM1, BUZZER_PWM_CHANNEL, 0, PWM_MATCH_UPDATE_NEXT_RST);
+        return;
+    }
+
+    uint32_t period = CLKPWR_GetPCLK(CLKPWR_PCLKSEL_PWM1) / frequency; /**< Ticks per tone period. */
+    PWM_MatchUpdate(LPC_PWM1, 0, period, PWM_MATCH_UPDATE_NEXT_RST);
+    PWM_MatchUpdate(LPC_PWM1, BUZZER_PWM_CHANNEL, period / 2, PWM_MATCH_UPDATE_NEXT_RST);
+}
+
+#else
+
+/**
+ * @brief Start the DAC and its looping GPDMA transfer.
+ */
+static void buzzer_backend_init(void)
+{
+    configure_dac();                           /**< Set up the DAC, with the current level's wave */
+    configure_dma_for_dac();                   /**< Configure the DMA for continuous wave output */
+    GPDMA_ChannelCmd(dac_dma_channel, ENABLE); /**< Enable the DMA channel for the DAC */
+}
+
+/**
+ * @brief Play the wave of a level, fading in from silence; the silent level fades the current wave out.
+ */
+static void buzzer_backend_play(uint8_t level)
+{
+    if (level == ZONE_CLEAR)
+    {
+        dac_release();
+        return;
+    }
+    dac_play(&dac_zone_wave[level]);
+}
+
+#endif
+
+#if BUZZER_BACKEND == BUZZER_BACKEND_DAC
+/**
+ * @brief Load the mixer voices from the scanned sensors and make sure the mixed stream is playing.
+ *
+ * Called at every cadence timer match, so the voices follow the distances as often as the single tone
+ * does. The DMA interrupt renders from the same voices and preempts TIMER1, so it is held off while they
+ * are rewritten; a block never mixes half of an update.
+ */
+static void buzzer_mix_update(void)
+{
+    dma_irq_lock();
+    for (uint8_t i = 0; i < MIXER_VOICES; i++)
+    {
+        if (i < adc_scan.count)
+        {
+            uint32_t frequency = buzzer_frequency(adc_scan.zone[i]) * (BUZZER_VOICE_STEP + i) / BUZZER_VOICE_STEP;
+            mixer_set_tone(&dac_mixer, i, frequency, BUZZER_VOICE_GAIN);
+            mixer_set_distance(&dac_mixer, i, adc_scan.distance[i]);
+        }
+        else
+        {
+            mixer_set_tone(&dac_mixer, i, 0, 0);
+        }
+    }
+    dma_irq_unlock();
+    dac_mix_start();
+}
+#endif
+
+/**
+ * @brief Tone frequency of an alarm level.
+ */
+uint32_t buzzer_frequency(uint8_t level)
+{
+    if (level == ZONE_CLEAR || level >= ZONE_COUNT)
+    {
+        return 0;
+    }
+    return dac_wave_frequency(&dac_zone_wave[level]);
+}
+
+/**
+ * @brief Start the selected backend and the beep cadence.
+ *
+ * TIMER1 counts microseconds and its match 0 resets the counter, so each match value is the length of one
+ * beep or one silence and the cadence follows `distance_mm` without SysTick quantization.
+ */
+void configure_buzzer(void)
+{
+    TIM_TIMERCFG_Type timer_cfg_struct; /**< Structure to store timer settings. */
+    TIM_MATCHCFG_Type match_cfg_struct; /**< Structure to store match configuration. */
+
+    buzzer_level = alarm_level;
+    buzzer_gate_open = TRUE;
+    buzzer_backend_init();
+    buzzer_backend_play(buzzer_level);
+
+    timer_cfg_struct.PrescaleOption = TIM_PRESCALE_USVAL; /**< Prescaler in microseconds. */
+    timer_cfg_struct.PrescaleValue = 1;                   /**< One count per microsecond. */
+
+    match_cfg_struct.MatchChannel = 0;                          /**< Matching channel 0. */
+    match_cfg_struct.IntOnMatch = ENABLE;                       /**< Interrupt at the end of each interval. */
+    match_cfg_struct.StopOnMatch = DISABLE;                     /**< Does not stop timer on match. */
+    match_cfg_struct.ResetOnMatch = ENABLE;                     /**< Reset timer on match. */
+    match_cfg_struct.ExtMatchOutputType = TIM_EXTMATCH_NOTHING; /**< No external match output. */
+    match_cfg_struct.MatchValue = CADENCE_ON_MS * 1000;         /**< First beep. */
+
+    TIM_Init(CADENCE_TIMER, TIM_TIMER_MODE, &timer_cfg_struct); /**< Initialize timer TIMER1. */
+    TIM_ConfigMatch(CADENCE_TIMER, &match_cfg_struct);          /**< Set up the match. */
+    NVIC_EnableIRQ(TIMER1_IRQn);                                /**< Enable interrupt for TIMER1. */
+    TIM_Cmd(CADENCE_TIMER, ENABLE);                             /**< Start the first beep. */
+}
+
+/**
+ * @brief Updates the tone to the current alarm level.
+ *
+ * The backends are not reentrant (dac_play() renders into a shared buffer), so the cadence is kept out
+ * while the tone changes.
+ */
+void update_buzzer(void)
+{
+    NVIC_DisableIRQ(TIMER1_IRQn);
+    buzzer_level = alarm_level;
+    if (buzzer_gate_open)
+    {
+        buzzer_backend_play(buzzer_level);
+    }
+    if (habilitar)
+    {
+        NVIC_EnableIRQ(TIMER1_IRQn); /**< Left masked while muted. */
+    }
+}
+
+/**
+ * @brief Enable or mute the buzzer.
+ *
+ * Muting stops the cadence and fades the tone out; enabling starts a new beep right away.
+ */
+void buzzer_enable(FunctionalState state)
+{
+    NVIC_DisableIRQ(TIMER1_IRQn);
+    if (state == ENABLE)
+    {
+        buzzer_gate_open = TRUE;
+        buzzer_backend_play(buzzer_level);
+        TIM_ResetCounter(CADENCE_TIMER);
+        TIM_UpdateMatchValue(CADENCE_TIMER, 0, CADENCE_ON_MS * 1000);
+        TIM_Cmd(CADENCE_TIMER, ENABLE);
+        NVIC_EnableIRQ(TIMER1_IRQn);
+    }
+    else
+    {
+        TIM_Cmd(CADENCE_TIMER, DISABLE);
+        TIM_ClearIntPending(CADENCE_TIMER, TIM_MR0_INT);
+#if BUZZER_BACKEND == BUZZER_BACKEND_DAC
+        dac_mix_stop(); /**< The voices have no release of their own. */
+#endif
+        buzzer_gate_open = FALSE;
+        buzzer_backend_play(ZONE_CLEAR);
+    }
+}
+
+/**
+ * @brief Enable change consumer of the buzzer.
+ */
+void buzzer_on_enable(uint32_t events)
+{
+    (void)events;
+    buzzer_enable(habilitar ? ENABLE : DISABLE);
+}
+
+/**
+ * @brief Zone change consumer of the buzzer.
+ *
+ * The tone only changes with the alarm level, so it is set once per transition.
+ */
+void buzzer_on_zone_change(uint32_t events)
+{
+    (void)events;
+    update_buzzer();
+}
+
+/**
+ * @brief Cadence timer interrupt handler (TIMER1).
+ *
+ * The cadence is recomputed at every edge, so a change of distance shows up in the next interval. With no
+ * silence (solid tone) the gate stays open and the timer only keeps checking the distance once per beep.
+ * Both backends switch tones on a period boundary, so the gate never clicks.
+ */
+void TIMER1_IRQHandler(void)
+{
+    cadence_t cadence;
+
+    TIM_ClearIntPending(CADENCE_TIMER, TIM_MR0_INT); /**< Clear the interrupt flag. */
+
+#if BUZZER_BACKEND == BUZZER_BACKEND_DAC
+    if (adc_acquisition_mode == ADC_MODE_SCAN)
+    {
+        buzzer_mix_update(); /**< Every voice has its own cadence, no gating here. */
+        TIM_UpdateMatchValue(CADENCE_TIMER, 0, CADENCE_ON_MS * 1000);
+        return;
+    }
+    if (dac_mixing)
+    {
+        dac_mix_stop();           /**< Back from a scan: silent... */
+        buzzer_gate_open = FALSE; /**< ...and the gate opens with an attack right below. */
+    }
+#endif
+
+    cadence_from_distance(distance_mm, &cadence);
+
+    if (buzzer_gate_open && cadence.off_us > 0)
+    {
+        buzzer_gate_open = FALSE;
+        buzzer_backend_play(ZONE_CLEAR); /**< Silence */
+        TIM_UpdateMatchValue(CADENCE_TIMER, 0, cadence.off_us);
+    }
+    else
+    {
+        if (!buzzer_gate_open)
+        {
+            buzzer_gate_open = TRUE;
+            buzzer_backend_play(buzzer_level);
+        }
+        TIM_UpdateMatchValue(CADENCE_TIMER, 0, cadence.on_us);
+    }
+}
@@ -0,0 +1,49 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleCadence.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleCadence.h"
+
+/**
+ * @file moduleCadence.c
+ * @brief Implementation of the distance to beep cadence curve.
+ */
+
+_Static_assert(CADENCE_SOLID_MM < CADENCE_FAR_MM, "CADENCE_SOLID_MM must be below CADENCE_FAR_MM");
+_Static_assert((uint64_t)CADENCE_OFF_MAX_MS * 1000 * (CADENCE_FAR_MM - CADENCE_SOLID_MM) <= UINT32_MAX,
+               "the silence interpolation must fit in 32 bits");
+
+/**
+ * @brief Beep cadence for a distance.
+ *
+ * One multiply and one division by a constant, done in microseconds so the silence changes with every
+ * millimetre instead of in steps.
+ */
+void cadence_from_distance(uint16_t distance_mm, cadence_t* cadence)
+{
+    uint32_t span = (distance_mm > CADENCE_FAR_MM) ? CADENCE_FAR_MM : distance_mm;
+
+    cadence->on_us = CADENCE_ON_MS * 1000;
+    if (span <= CADENCE_SOLID_MM)
+    {
+        cadence->off_us = 0;
+        return;
+    }
+
+    span -= CADENCE_SOLID_MM;
+    cadence->off_us = (CADENCE_OFF_MAX_MS * 1000 * span) / (CADENCE_FAR_MM - CADENCE_SOLID_MM);
+    if (cadence->off_us < CADENCE_OFF_MIN_MS * 1000)
+    {
+        cadence->off_us = 0;
+    }
+}
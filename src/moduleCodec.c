@@ -0,0 +1,273 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleCodec.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleCodec.h"
+
+/**
+ * @file moduleCodec.c
+ * @brief Implementation of the sample block codec.
+ */
+
+/**
+ * @defgroup Decoder states
+ * @brief Value of `codec_decoder_t::state`.
+ *
+ */
+#define STATE_COUNT   0 ///< Sample count varint.
+#define STATE_FIRST   1 ///< First sample varint.
+#define STATE_CONTROL 2 ///< Control byte of a run.
+#define STATE_NIBBLES 3 ///< Bytes of a nibble run.
+#define STATE_VARINTS 4 ///< Varints of a varint run.
+
+#define CONTROL_VARINT 0x80 ///< Control byte flag of a varint run.
+#define CONTROL_LENGTH 0x7F ///< Control byte field holding the run length minus one.
+
+/**
+ * @brief Zigzag code of the difference between two samples, modulo 2^16.
+ */
+static inline uint16_t zigzag(uint16_t sample, uint16_t previous)
+{
+    int16_t delta = (int16_t)(uint16_t)(sample - previous);
+    return (uint16_t)(((uint16_t)delta << 1) ^ (uint16_t)(delta >> 15));
+}
+
+/**
+ * @brief Sample following `previous` by the difference of a zigzag code.
+ */
+static inline uint16_t unzigzag(uint16_t code, uint16_t previous)
+{
+    return (uint16_t)(previous + ((code >> 1) ^ (uint16_t)-(code & 1)));
+}
+
+/**
+ * @brief Write a varint, seven bits per byte, least significant first.
+ */
+static size_t put_varint(uint8_t* out, uint16_t value)
+{
+    size_t length = 0;
+
+    while (value >= 0x80)
+    {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+/**
+ * @brief Number of consecutive codes below 16 from `index`, at most `limit`.
+ */
+static size_t small_run(const uint16_t* samples, size_t index, size_t limit)
+{
+    size_t length = 0;
+
+    while (length < limit && zigzag(samples[index + length], samples[index + length - 1]) <= CODEC_NIBBLE_MAX)
+    {
+        length++;
+    }
+    return length;
+}
+
+/**
+ * @brief Encode a block of samples.
+ *
+ * Greedy run selection: a stretch of at least `CODEC_NIBBLE_MIN` small codes becomes a nibble run, any
+ * other code goes into a varint run, which ends where such a stretch begins. Looking ahead never costs more
+ * than `CODEC_NIBBLE_MIN` codes per sample.
+ */
+size_t codec_encode_block(const uint16_t* samples, size_t count, uint8_t* out)
+{
+    size_t length = put_varint(out, (uint16_t)count);
+    size_t i = 1;
+
+    if (count == 0)
+    {
+        return length;
+    }
+    length += put_varint(out + length, samples[0]);
+
+    while (i < count)
+    {
+        size_t limit = count - i;
+        size_t run;
+
+        limit = (limit > CODEC_RUN_MAX) ? CODEC_RUN_MAX : limit;
+        run = small_run(samples, i, limit);
+        if (run >= CODEC_NIBBLE_MIN || run == limit)
+        {
+            out[length++] = (uint8_t)(run - 1);
+            for (size_t k = 0; k < run; k += 2)
+            {
+                uint8_t byte = (uint8_t)zigzag(samples[i + k], samples[i + k - 1]);
+                if (k + 1 < run)
+                {
+                    byte |= (uint8_t)(zigzag(samples[i + k + 1], samples[i + k]) << 4);
+                }
+                out[length++] = byte;
+            }
+            i += run;
+            continue;
+        }
+
+        size_t control = length++;
+        run = 0;
+        while (run < limit)
+        {
+            size_t ahead = limit - run;
+            ahead = (ahead > CODEC_NIBBLE_MIN) ? CODEC_NIBBLE_MIN : ahead;
+            if (small_run(samples, i + run, ahead) == CODEC_NIBBLE_MIN)
+            {
+                break; /**< A nibble run starts here; never at run 0, checked above. */
+            }
+            length += put_varint(out + length, zigzag(samples[i + run], samples[i + run - 1]));
+            run++;
+        }
+        out[control] = (uint8_t)(CONTROL_VARINT | (run - 1));
+        i += run;
+    }
+    return length;
+}
+
+/**
+ * @brief Prepare a decoder to expect the start of a block.
+ */
+void codec_decoder_init(codec_decoder_t* decoder)
+{
+    decoder->state = STATE_COUNT;
+    decoder->shift = 0;
+    decoder->value = 0;
+    decoder->remaining = 0;
+    decoder->run = 0;
+    decoder->previous = 0;
+    decoder->blocks = 0;
+    decoder->errors = 0;
+}
+
+/**
+ * @brief Accumulate one varint byte.
+ *
+ * @return 1 when the varint is complete, 0 if more bytes follow, -1 if it does not fit in 16 bits.
+ */
+static int take_varint(codec_decoder_t* decoder, uint8_t byte)
+{
+    if (decoder->shift == 7 * (CODEC_VARINT_MAX - 1) && (byte & 0xFC))
+    {
+        return -1;
+    }
+    decoder->value |= (uint16_t)((byte & 0x7F) << decoder->shift);
+    if (byte & 0x80)
+    {
+        decoder->shift += 7;
+        return 0;
+    }
+    decoder->shift = 0;
+    return 1;
+}
+
+/**
+ * @brief Account for one produced sample and close the block after its last one.
+ */
+static void advance(codec_decoder_t* decoder, uint16_t sample)
+{
+    decoder->previous = sample;
+    if (--decoder->remaining == 0)
+    {
+        decoder->state = STATE_COUNT;
+        decoder->blocks++;
+    }
+    else if (--decoder->run == 0)
+    {
+        decoder->state = STATE_CONTROL;
+    }
+}
+
+/**
+ * @brief Feed one encoded byte to a decoder.
+ *
+ * Constant work per byte. On a malformed block the decoder counts an error and expects a new block.
+ */
+size_t codec_decoder_feed(codec_decoder_t* decoder, uint8_t byte, uint16_t samples[2])
+{
+    size_t produced = 0;
+    int done;
+
+    switch (decoder->state)
+    {
+        case STATE_COUNT:
+        case STATE_FIRST:
+        case STATE_VARINTS:
+            done = take_varint(decoder, byte);
+            if (done < 0)
+            {
+                break;
+            }
+            if (done == 0)
+            {
+                return 0;
+            }
+            if (decoder->state == STATE_COUNT)
+            {
+                decoder->remaining = decoder->value;
+                decoder->state = (decoder->remaining > 0) ? STATE_FIRST : STATE_COUNT;
+                decoder->blocks += (decoder->remaining == 0);
+            }
+            else if (decoder->state == STATE_FIRST)
+            {
+                samples[produced++] = decoder->value;
+                decoder->previous = decoder->value;
+                decoder->state = (--decoder->remaining > 0) ? STATE_CONTROL : STATE_COUNT;
+                decoder->blocks += (decoder->remaining == 0);
+            }
+            else
+            {
+                samples[produced] = unzigzag(decoder->value, decoder->previous);
+                advance(decoder, samples[produced++]);
+            }
+            decoder->value = 0;
+            return produced;
+        case STATE_CONTROL:
+            decoder->run = (uint8_t)((byte & CONTROL_LENGTH) + 1);
+            if (decoder->run > decoder->remaining)
+            {
+                break;
+            }
+            decoder->state = (byte & CONTROL_VARINT) ? STATE_VARINTS : STATE_NIBBLES;
+            return 0;
+        case STATE_NIBBLES:
+            samples[produced] = unzigzag(byte & 0x0F, decoder->previous);
+            advance(decoder, samples[produced++]);
+            if (decoder->state == STATE_NIBBLES)
+            {
+                samples[produced] = unzigzag(byte >> 4, decoder->previous);
+                advance(decoder, samples[produced++]);
+            }
+            return produced;
+        default: break;
+    }
+
+    decoder->errors++;
+    decoder->state = STATE_COUNT;
+    decoder->shift = 0;
+    decoder->value = 0;
+    return produced;
+}
+
+/**
+ * @brief Whether the decoder sits between two blocks.
+ */
+int codec_decoder_idle(const codec_decoder_t* decoder)
+{
+    return decoder->state == STATE_COUNT && decoder->shift == 0;
+}
@@ -0,0 +1,343 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleCommand.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleCommand.h"
+#include "moduleFormat.h"
+
+/**
+ * @file moduleCommand.c
+ * @brief Implementation of the command line parser.
+ */
+
+/**
+ * @defgroup Parser states
+ * @brief Value of `command_parser_t::state`.
+ *
+ */
+#define STATE_START   0 ///< Start of a line, blanks skipped.
+#define STATE_VERB    1 ///< Inside the verb.
+#define STATE_BLANK   2 ///< Between two words.
+#define STATE_NUMBER  3 ///< Inside an argument.
+#define STATE_DISCARD 4 ///< Invalid line, skipped up to its end.
+#define STATE_CHECK   5 ///< Inside the checksum, after the `*`.
+
+#define COMMAND_CHECK_DIGITS 2 ///< Hexadecimal digits of a checksum.
+
+/**
+ * @brief One verb of the table, with its number of arguments.
+ */
+typedef struct
+{
+    const char* name; ///< Lowercase verb.
+    uint8_t id;       ///< COMMAND_* value.
+    uint8_t min_args; ///< Fewest arguments accepted.
+    uint8_t max_args; ///< Most arguments accepted.
+} command_verb_t;
+
+/// Verbs, at most eight: `command_parser_t::candidates` has one bit per entry.
+static const command_verb_t command_verbs[] = {
+    {"zone", COMMAND_ZONE, 3, 3},
+    {"rate", COMMAND_RATE, 1, 1},
+    {"telemetry", COMMAND_TELEMETRY, 1, 1},
+    {"mode", COMMAND_MODE, 1, 1},
+    {"baud", COMMAND_BAUD, 0, 1},
+    {"status", COMMAND_STATUS, 0, 0},
+    {"batch", COMMAND_BATCH, 1, 2},
+};
+
+#define VERB_COUNT (sizeof(command_verbs) / sizeof(command_verbs[0]))
+#define VERB_ALL   ((uint8_t)((1u << VERB_COUNT) - 1))
+
+/**
+ * @brief Drop the line in progress, keeping the counters.
+ */
+void command_parser_reset(command_parser_t* parser)
+{
+    parser->state = STATE_START;
+    parser->candidates = VERB_ALL;
+    parser->position = 0;
+    parser->sum = 0;
+    parser->check = 0;
+    parser->check_digits = 0;
+    parser->command.id = COMMAND_NONE;
+    parser->command.argc = 0;
+}
+
+/**
+ * @brief Prepare a parser at the start of a line, with cleared counters.
+ */
+void command_parser_init(command_parser_t* parser)
+{
+    command_parser_reset(parser);
+    parser->lines = 0;
+    parser->errors = 0;
+    parser->checksum_errors = 0;
+}
+
+/**
+ * @brief Keep the candidates whose verb has `c` at the current position.
+ *
+ * A candidate is dropped as soon as one character differs, so its name is never read past its end.
+ */
+static void command_match(command_parser_t* parser, char c)
+{
+    uint8_t candidates = parser->candidates;
+
+    for (uint8_t i = 0; i < VERB_COUNT; i++)
+    {
+        if ((candidates & (1u << i)) && command_verbs[i].name[parser->position] != c)
+        {
+            candidates &= (uint8_t)~(1u << i);
+        }
+    }
+    parser->candidates = candidates;
+    if (parser->position < UINT8_MAX)
+    {
+        parser->position++;
+    }
+}
+
+/**
+ * @brief The verb is complete: resolve it to the only candidate whose name also ends here.
+ *
+ * @return 0 if it names a command, -1 otherwise.
+ */
+static int command_resolve(command_parser_t* parser)
+{
+    command_match(parser, '\0');
+    for (uint8_t i = 0; i < VERB_COUNT; i++)
+    {
+        if (parser->candidates & (1u << i))
+        {
+            parser->command.id = (uint8_t)i; /**< Table index until the line is complete. */
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief The line is complete: check the number of arguments.
+ *
+ * @return 0 if the command is valid, -1 otherwise.
+ */
+static int command_finish(command_parser_t* parser, command_t* command)
+{
+    const command_verb_t* verb = &command_verbs[parser->command.id];
+
+    *command = parser->command;
+    if (command->argc < verb->min_args || command->argc > verb->max_args)
+    {
+        command->id = COMMAND_INVALID;
+        return -1;
+    }
+    command->id = verb->id;
+    return 0;
+}
+
+/**
+ * @brief Value of a lowercase hexadecimal digit.
+ *
+ * @return 0 to 15, or 0xFF if `c` is not a digit.
+ */
+static uint8_t command_hex(uint8_t c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return (uint8_t)(c - '0');
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return (uint8_t)(c - 'a' + 10);
+    }
+    return 0xFF;
+}
+
+/**
+ * @brief Feed received bytes to the parser.
+ *
+ * One switch per byte; only the verb characters loop, over the table of verbs. The checksum is kept up to
+ * date on every byte, as received, so it costs one XOR whether the line carries one or not.
+ */
+size_t command_feed(command_parser_t* parser, const uint8_t* data, size_t length, command_t* command)
+{
+    command->id = COMMAND_NONE;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        uint8_t c = data[i];
+        uint8_t end = (c == '\n' || c == '\r');
+        uint8_t blank = (c == ' ' || c == '\t');
+        uint8_t digit = (c >= '0' && c <= '9');
+
+        if (c < ' ' && !end && !blank)
+        {
+            command_parser_reset(parser); /**< Line noise, a break or a new rate: start over. */
+            continue;
+        }
+        if (parser->state != STATE_CHECK && c != '*' && !end && (parser->state != STATE_START || !blank))
+        {
+            parser->sum ^= c;
+        }
+        if (c >= 'A' && c <= 'Z')
+        {
+            c = (uint8_t)(c + ('a' - 'A'));
+        }
+
+        switch (parser->state)
+        {
+            case STATE_START:
+                if (blank || end)
+                {
+                    break; /**< Blank line or leading blanks. */
+                }
+                parser->state = STATE_VERB;
+                command_match(parser, (char)c);
+                break;
+            case STATE_VERB:
+                if (!blank && !end && c != '*')
+                {
+                    command_match(parser, (char)c);
+                    break;
+                }
+                if (command_resolve(parser) != 0)
+                {
+                    parser->state = STATE_DISCARD;
+                }
+                else
+                {
+                    parser->state = (c == '*') ? STATE_CHECK : STATE_BLANK;
+                }
+                break;
+            case STATE_BLANK:
+                if (digit && parser->command.argc < COMMAND_MAX_ARGS)
+                {
+                    parser->command.argv[parser->command.argc++] = (uint32_t)(c - '0');
+                    parser->state = STATE_NUMBER;
+                }
+                else if (c == '*')
+                {
+                    parser->state = STATE_CHECK;
+                }
+                else if (!blank && !end)
+                {
+                    parser->state = STATE_DISCARD; /**< Not a number, or one argument too many. */
+                }
+                break;
+            case STATE_NUMBER:
+            {
+                uint32_t* value = &parser->command.argv[parser->command.argc - 1];
+                if (digit && *value <= (UINT32_MAX - (c - '0')) / 10)
+                {
+                    *value = *value * 10 + (uint32_t)(c - '0');
+                }
+                else if (blank || end)
+                {
+                    parser->state = STATE_BLANK;
+                }
+                else if (c == '*')
+                {
+                    parser->state = STATE_CHECK;
+                }
+                else
+                {
+                    parser->state = STATE_DISCARD; /**< Overflow or stray character. */
+                }
+                break;
+            }
+            case STATE_CHECK:
+            {
+                uint8_t hex = command_hex(c);
+                if (hex != 0xFF && parser->check_digits < COMMAND_CHECK_DIGITS)
+                {
+                    parser->check = (uint8_t)((parser->check << 4) | hex);
+                    parser->check_digits++;
+                }
+                else if (!end && !(blank && parser->check_digits == COMMAND_CHECK_DIGITS))
+                {
+                    parser->state = STATE_DISCARD; /**< Malformed checksum or text after it. */
+                }
+                break;
+            }
+            default: break;
+        }
+
+        if (end && parser->state != STATE_START)
+        {
+            if (parser->state == STATE_CHECK &&
+                (parser->check_digits != COMMAND_CHECK_DIGITS || parser->check != parser->sum))
+            {
+                parser->state = STATE_DISCARD;
+                parser->checksum_errors++;
+            }
+            if (parser->state == STATE_DISCARD)
+            {
+                command->id = COMMAND_INVALID;
+                command->argc = 0;
+                parser->errors++;
+            }
+            else if (command_finish(parser, command) == 0)
+            {
+                parser->lines++;
+            }
+            else
+            {
+                parser->errors++;
+            }
+            command_parser_reset(parser);
+            return i + 1;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Verb of a command, for replies.
+ */
+const char* command_name(uint8_t id)
+{
+    for (uint8_t i = 0; i < VERB_COUNT; i++)
+    {
+        if (command_verbs[i].id == id)
+        {
+            return command_verbs[i].name;
+        }
+    }
+    return "?";
+}
+
+/**
+ * @brief Build the reply line to a command.
+ */
+size_t command_reply(const command_t* command, int result, uint32_t value, char* out)
+{
+    char* p = out;
+
+    p += format_text(p, command_name(command->id));
+    if (command->id == COMMAND_INVALID)
+    {
+        p += format_text(p, ": invalid");
+    }
+    else
+    {
+        p += format_text(p, (result == 0) ? ": ok" : ": rejected");
+    }
+    if (value != 0)
+    {
+        *p++ = ' ';
+        p += format_unsigned(p, value);
+    }
+    *p++ = '\n';
+    return (size_t)(p - out);
+}
@@ -14,20 +14,70 @@
  ****************************************************************************/
 #include "moduleDAC.h"
 
-volatile uint32_t dac_value[NUM_SAMPLES] = {1000, 700, 400, 0};
-volatile uint32_t dac_value1[NUM_SAMPLES] = {1000, 700, 400, 0};
-volatile uint32_t dac_value2[NUM_SAMPLES] = {800, 800, 800, 800};
+/// One period of a sine, full scale around DAC_MIDSCALE.
+static const uint16_t dac_sine_table[DAC_WAVE_POINTS] = {
+    512, 562, 612, 660, 708, 753, 796, 836, 873, 907, 937, 963, 984, 1001, 1013, 1021,
+    1023, 1021, 1013, 1001, 984, 963, 937, 907, 873, 836, 796, 753, 708, 660, 612, 562,
+    512, 462, 412, 364, 316, 271, 228, 188, 151, 117, 87, 61, 40, 23, 11, 3,
+    1, 3, 11, 23, 40, 61, 87, 117, 151, 188, 228, 271, 316, 364, 412, 462};
+
+/// One period of a square, same amplitude as the sine.
+static const uint16_t dac_square_table[DAC_WAVE_POINTS] = {
+    1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023,
+    1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023, 1023,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+
+/// Output at rest.
+static const uint16_t dac_silence_table[1] = {DAC_MIDSCALE};
+
+const dac_wave_t dac_zone_wave[ZONE_COUNT] = {
+    {dac_silence_table, 1, 1, DAC_UPDATE_RATE},              /**< Clear: silent */
+    {dac_sine_table, DAC_WAVE_POINTS, 1, DAC_UPDATE_RATE},   /**< Caution: 400 Hz sine */
+    {dac_sine_table, DAC_WAVE_POINTS, 2, DAC_UPDATE_RATE},   /**< Warning: 800 Hz sine */
+    {dac_square_table, DAC_WAVE_POINTS, 4, DAC_UPDATE_RATE}, /**< Danger: 1600 Hz square */
+};
+
+volatile uint32_t dac_buffer[2][DAC_WAVE_POINTS + 1];
+
+uint8_t dac_dma_channel = DMA_NONE;
+
+mixer_t dac_mixer;
+
+volatile uint8_t dac_mixing = FALSE;
+
+cycle_stats_t dac_mix_stats;
+
+_Static_assert((1 << DAC_WAVE_LOG2) == DAC_WAVE_POINTS, "DAC_WAVE_LOG2 must match DAC_WAVE_POINTS");
+
+/// Linked list item of each buffer, two consecutive items of the DMA pool.
+static GPDMA_LLI_Type* dac_dma_lli = NULL;
+
+/// Buffer the chain ends in: the one being played, or the one queued to be played next.
+static volatile uint8_t dac_active = 0;
+
+/// Wave rendered into the buffers.
+static const dac_wave_t* volatile dac_wave = &dac_zone_wave[ZONE_CLEAR];
+
+/// Envelope gain of the last queued period and the gain it is moving to, Q`DAC_GAIN_Q`.
+static volatile uint16_t dac_gain = 0;
+static volatile uint16_t dac_gain_target = 0;
+
+/// TRUE while the gain has not reached its target, periods are then queued from the DMA interrupt.
+static volatile uint8_t dac_ramping = FALSE;
+
+/// TRUE when @ref dac_mix_start found the idle buffer still playing, the DMA interrupt starts the mix.
+static volatile uint8_t dac_mix_pending = FALSE;
 
 /**
  * @brief Set the DAC.
  *
- * Configures the DAC to operate in counter mode with DMA enabled, using a calculated interval to
- * generate a desired frequency signal.
+ * Configures the DAC to operate in counter mode with DMA enabled; the update interval comes from the wave
+ * of the current alarm level. The DAC takes the most urgent GPDMA channel, a late request is audible.
  */
 void configure_dac(void)
 {
     DAC_CONVERTER_CFG_Type DAC_Struct; /**< DAC configuration structure */
-    uint32_t update_interval;          /**< Update interval between samples */
 
     // DAC Setup
     DAC_Struct.DBLBUF_ENA = RESET; /**< Disable double buffering */
@@ -35,9 +85,15 @@ void configure_dac(void)
     DAC_Struct.DMA_ENA = SET;      /**< Enable DAC DMA mode */
     DAC_Init(LPC_DAC);             /**< Initialize the DAC */
 
-    // Calculate the update interval for the desired wave frequency
-    update_interval = (CLOCK_DAC_MHZ * 1000000) / (WAVE_FREQUENCY * NUM_SAMPLES);
-    DAC_SetDMATimeOut(LPC_DAC, update_interval); /**< Set the timeout interval between samples */
+    dac_dma_channel = dma_channel_reserve(DMA_PRIORITY_DAC, dac_on_dma); /**< Interrupts on ramps and changes */
+    dac_dma_lli = dma_lli_alloc(dac_dma_channel, 2);
+
+    // Voices for the multi-sensor output, all muted
+    mixer_init(&dac_mixer, dac_sine_table, DAC_WAVE_LOG2, DAC_MIDSCALE, DAC_UPDATE_RATE);
+    cycle_stats_reset(&dac_mix_stats);
+
+    // Render the first wave and set the timeout interval between samples
+    dac_play(&dac_zone_wave[alarm_level]);
 
     // Apply DAC settings
     DAC_ConfigDAConverterControl(LPC_DAC, &DAC_Struct);
@@ -46,61 +102,334 @@ void configure_dac(void)
 /**
  * @brief Set the DMA to transfer data to the DAC.
  *
- * Configures the DMA to perform continuous transfers from a data table over the DAC channel,
- * using a linked list structure for continuous transfer.
+ * Configures the DMA to perform continuous transfers from the active buffer over the DAC channel. Each
+ * buffer has its own linked list item, which loops on itself until @ref dac_play links it to the other one.
  *
  */
-void configure_dma_for_dac(volatile uint32_t* table)
+void configure_dma_for_dac(void)
 {
-    GPDMA_LLI_Type DMA_LLI_Struct; /**< DMA linked list element for continuous transfer */
+    uint8_t active = dac_active; /**< Buffer rendered by the last dac_play() */
+    uint32_t length = GPDMA_DMACCxControl_TransferSize(dac_dma_lli[active].Control);
 
-    // Configure the DMA linked list for continuous transfer
-    DMA_LLI_Struct.SrcAddr = (uint32_t)table;              /**< Source address: wave table */
-    DMA_LLI_Struct.DstAddr = (uint32_t) & (LPC_DAC->DACR); /**< Destination address: DAC register */
-    DMA_LLI_Struct.NextLLI = (uint32_t)&DMA_LLI_Struct;    /**< Link to same item for continuous transfer */
-    DMA_LLI_Struct.Control = DMA_SIZE                      /**< Transfer size */
-                             | (2 << 18)                   /**< Source width: 32 bits */
-                             | (2 << 21)                   /**< Target width: 32 bits */
-                             | (1 << 26);                  /**< Increment source address */
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        uint32_t size = GPDMA_DMACCxControl_TransferSize(dac_dma_lli[i].Control); /**< Set by dac_play() */
+        uint32_t ramp = dac_dma_lli[i].Control & GPDMA_DMACCxControl_I;            /**< Set by dac_play() */
 
-    // Initialize the DMA module
-    GPDMA_Init();
+        // Configure the DMA linked list for continuous transfer
+        dac_dma_lli[i].SrcAddr = (uint32_t)dac_buffer[i];      /**< Source address: rendered wave */
+        dac_dma_lli[i].DstAddr = (uint32_t) & (LPC_DAC->DACR); /**< Destination address: DAC register */
+        dac_dma_lli[i].NextLLI = (uint32_t)&dac_dma_lli[i];    /**< Link to same item for continuous transfer */
+        dac_dma_lli[i].Control = size                          /**< Transfer size */
+                                 | (2 << 18)                   /**< Source width: 32 bits */
+                                 | (2 << 21)                   /**< Target width: 32 bits */
+                                 | (1 << 26)                   /**< Increment source address */
+                                 | ramp;                       /**< Terminal count interrupt during a ramp */
+    }
 
     GPDMA_Channel_CFG_Type GPDMACfg; /**< DMA channel configuration structure */
 
     // Configuration of the DMA channel for memory transfer to peripheral
-    GPDMACfg.ChannelNum = CHANNEL_DMA_DAC;          /**< Channel 0 */
-    GPDMACfg.SrcMemAddr = (uint32_t)table;          /**< Source address: wave table */
-    GPDMACfg.DstMemAddr = 0;                        /**< Without destination address in memory (peripheral) */
-    GPDMACfg.TransferSize = DMA_SIZE;               /**< Transfer size */
-    GPDMACfg.TransferWidth = 0;                     /**< Not used */
-    GPDMACfg.TransferType = GPDMA_TRANSFERTYPE_M2P; /**< Memory transfer to peripheral */
-    GPDMACfg.SrcConn = 0;                           /**< Source is memory */
-    GPDMACfg.DstConn = GPDMA_CONN_DAC;              /**< Destination: DAC connection */
-    GPDMACfg.DMALLI = (uint32_t)&DMA_LLI_Struct;    /**< Linked list for continuous transfer */
+    GPDMACfg.ChannelNum = dac_dma_channel;              /**< Reserved DAC channel */
+    GPDMACfg.SrcMemAddr = (uint32_t)dac_buffer[active]; /**< Source address: rendered wave */
+    GPDMACfg.DstMemAddr = 0;                            /**< Without destination address in memory (peripheral) */
+    GPDMACfg.TransferSize = length;                     /**< Transfer size */
+    GPDMACfg.TransferWidth = 0;                         /**< Not used */
+    GPDMACfg.TransferType = GPDMA_TRANSFERTYPE_M2P;     /**< Memory transfer to peripheral */
+    GPDMACfg.SrcConn = 0;                               /**< Source is memory */
+    GPDMACfg.DstConn = GPDMA_CONN_DAC;                  /**< Destination: DAC connection */
+    GPDMACfg.DMALLI = (uint32_t)&dac_dma_lli[active];   /**< Keep looping over the same buffer */
 
     // Apply DMA settings
     GPDMA_Setup(&GPDMACfg);
 }
 
 /**
- * @brief Updates the data to be converted by the DAC.
+ * @brief Number of DAC updates in one period of a wave.
+ */
+uint32_t dac_wave_length(const dac_wave_t* wave)
+{
+    return wave->points / wave->stride;
+}
+
+/**
+ * @brief DAC timeout between updates of a wave.
+ */
+uint32_t dac_wave_timeout(const dac_wave_t* wave)
+{
+    return (CLOCK_DAC_MHZ * 1000000) / wave->update_rate;
+}
+
+/**
+ * @brief Tone frequency of a wave.
+ */
+uint32_t dac_wave_frequency(const dac_wave_t* wave)
+{
+    return wave->update_rate / dac_wave_length(wave);
+}
+
+/**
+ * @brief Whether the GPDMA is still playing the idle buffer.
  *
+ * True after a swap that has not been taken yet: the active item is only fetched when the period in
+ * progress ends.
  */
-void update_dac(void)
+static uint8_t dac_idle_busy(void)
 {
-    if (reverse_flag == TRUE)
+    uint32_t start = (uint32_t)dac_buffer[dac_active ^ 1];
+    uint32_t end = (uint32_t)&dac_buffer[dac_active ^ 1][DAC_WAVE_POINTS];
+    LPC_GPDMACH_TypeDef* regs = dma_channel_regs(dac_dma_channel);
+
+    return (LPC_GPDMA->DMACEnbldChns & GPDMA_DMACEnbldChns_Ch(dac_dma_channel)) && regs->DMACCSrcAddr >= start &&
+           regs->DMACCSrcAddr <= end;
+}
+
+/**
+ * @brief Render the next period of the current wave and queue it after the active one.
+ *
+ * The gain takes one step towards its target first, so an envelope advances once per period, never per
+ * sample. The table is read every `stride` entries and scaled around midscale:
+ * `midscale + (entry - midscale) * gain / DAC_GAIN_FULL`. Only the idle buffer is written: the chain is
+ * `active -> active -> ...` and the idle item is not reachable from it, so the GPDMA never reads a half
+ * rendered period. Linking the active item to the idle one makes the GPDMA continue with the new period
+ * when the one in progress ends.
+ *
+ * While the gain is still moving the new item raises a terminal count interrupt, and @ref dac_on_dma
+ * renders the following period from there; the last period of a ramp has no interrupt and loops on itself.
+ * The caller must make sure the idle buffer is not being played (@ref dac_idle_busy).
+ */
+static void dac_queue_period(void)
+{
+    uint8_t idle = dac_active ^ 1;
+    const dac_wave_t* wave = dac_wave;
+    uint32_t length = dac_wave_length(wave);
+    int32_t gain;
+    uint32_t control;
+
+    if (dac_gain < dac_gain_target)
     {
-        for (int i = 0; i < NUM_SAMPLES; i++)
+        dac_gain = (dac_gain_target - dac_gain > DAC_ATTACK_STEP) ? dac_gain + DAC_ATTACK_STEP : dac_gain_target;
+    }
+    else if (dac_gain > dac_gain_target)
+    {
+        dac_gain = (dac_gain - dac_gain_target > DAC_RELEASE_STEP) ? dac_gain - DAC_RELEASE_STEP : dac_gain_target;
+    }
+    gain = dac_gain;
+
+    for (uint32_t i = 0; i < length; i++)
+    {
+        int32_t offset = (int32_t)wave->table[i * wave->stride] - DAC_MIDSCALE;
+        dac_buffer[idle][i] = (uint32_t)(DAC_MIDSCALE + ((offset * gain) >> DAC_GAIN_Q)) << DAC_VALUE_SHIFT;
+    }
+
+    dac_ramping = (dac_gain != dac_gain_target);
+    control = dac_dma_lli[idle].Control & ~(GPDMA_DMACCxControl_TransferSize(0xFFF) | GPDMA_DMACCxControl_I);
+    dac_dma_lli[idle].Control = control | length | (dac_ramping ? GPDMA_DMACCxControl_I : 0);
+    dac_dma_lli[idle].NextLLI = (uint32_t)&dac_dma_lli[idle];       /**< The new period loops on itself... */
+    dac_dma_lli[dac_active].NextLLI = (uint32_t)&dac_dma_lli[idle]; /**< ...once the old one hands over */
+    dac_active = idle;
+
+    DAC_SetDMATimeOut(LPC_DAC, dac_wave_timeout(wave));
+}
+
+/**
+ * @brief Have the DMA interrupt finish a change the idle buffer is not free for yet.
+ *
+ * The active item loops on itself, so its terminal count interrupt comes at the end of its next pass at
+ * the latest, once the GPDMA has left the idle buffer. If the item was fetched before the bit was set,
+ * the pass that follows has it.
+ */
+static void dac_defer(void)
+{
+    dac_dma_lli[dac_active].Control |= GPDMA_DMACCxControl_I;
+}
+
+/**
+ * @brief Move the output towards a wave and a gain.
+ *
+ * During a ramp the next terminal count picks the new wave and target up, and while mixing, or about to,
+ * they are only recorded for @ref dac_mix_stop to start from. Otherwise the first period is queued right
+ * away; if the previous swap has not been taken yet the idle buffer is still being played, and the change
+ * is left to the DMA interrupt as during a ramp instead of waiting up to two periods here: this runs from
+ * the cadence interrupt.
+ *
+ * The DMA interrupt is masked meanwhile, @ref dac_on_dma renders into the same buffers.
+ */
+static void dac_set(const dac_wave_t* wave, uint16_t gain)
+{
+    dma_irq_lock();
+    dac_wave = wave;
+    dac_gain_target = gain;
+
+    if (!dac_ramping && !dac_mixing && !dac_mix_pending)
+    {
+        if (dac_idle_busy())
+        {
+            dac_ramping = TRUE; /**< The terminal count queues the period, see dac_on_dma. */
+            dac_defer();
+        }
+        else
         {
-            dac_value[i] = dac_value1[i];
+            dac_queue_period();
         }
     }
-    else
+    dma_irq_unlock();
+}
+
+/**
+ * @brief Play a wave.
+ *
+ * A wave started from silence fades in with the attack ramp; a change of wave while sounding keeps the
+ * current gain and takes place on a period boundary.
+ */
+void dac_play(const dac_wave_t* wave)
+{
+    dac_set(wave, DAC_GAIN_FULL);
+}
+
+/**
+ * @brief Fade the current wave out.
+ */
+void dac_release(void)
+{
+    dac_set(dac_wave, 0);
+}
+
+/**
+ * @brief Buffer the GPDMA is reading, from its source address.
+ */
+static uint8_t dac_playing(void)
+{
+    uint32_t src = dma_channel_regs(dac_dma_channel)->DMACCSrcAddr;
+
+    return (src >= (uint32_t)dac_buffer[1] && src <= (uint32_t)&dac_buffer[1][DAC_WAVE_POINTS]) ? 1 : 0;
+}
+
+/**
+ * @brief Render the next mixed block into a buffer.
+ */
+static void dac_mix_render(uint8_t buffer)
+{
+    uint32_t start = cycle_count();
+
+    mixer_render(&dac_mixer, dac_buffer[buffer], DAC_MIX_BLOCK, DAC_VALUE_SHIFT);
+    cycle_stats_add(&dac_mix_stats, cycle_count() - start);
+}
+
+/**
+ * @brief Link the first mixed block after the playing buffer.
+ *
+ * The first block goes into the idle buffer, linked back to the playing one, and the playing item is
+ * linked to it: the chain becomes the ring `idle -> playing -> idle...`. The playing buffer still holds
+ * the looping wave; it is played once more (already fetched) with a terminal count interrupt, and from
+ * then on every interrupt finds the GPDMA in the other buffer and renders the one it left. The links
+ * never change while mixing, so no block is repeated. The idle buffer must be free.
+ */
+static void dac_mix_begin(void)
+{
+    uint8_t playing = dac_active;
+    uint8_t idle = playing ^ 1;
+    uint32_t control = dac_dma_lli[idle].Control & ~GPDMA_DMACCxControl_TransferSize(0xFFF);
+
+    dac_mixing = TRUE;
+    dac_mix_pending = FALSE;
+    dac_ramping = FALSE;
+    dac_mix_render(idle);
+    dac_dma_lli[idle].Control = control | DAC_MIX_BLOCK | GPDMA_DMACCxControl_I;
+    dac_dma_lli[idle].NextLLI = (uint32_t)&dac_dma_lli[playing];
+    dac_dma_lli[playing].Control |= GPDMA_DMACCxControl_I;
+    dac_dma_lli[playing].NextLLI = (uint32_t)&dac_dma_lli[idle];
+    DAC_SetDMATimeOut(LPC_DAC, (CLOCK_DAC_MHZ * 1000000) / DAC_UPDATE_RATE);
+}
+
+/**
+ * @brief Switch the output to the mixed stream of `dac_mixer`.
+ *
+ * If the previous swap has not been taken yet the idle buffer is still being played; the mix is then
+ * started by the DMA interrupt once the GPDMA has left it, instead of waiting here in the cadence
+ * interrupt.
+ */
+void dac_mix_start(void)
+{
+    dma_irq_lock();
+    if (!dac_mixing && !dac_mix_pending)
     {
-        for (int i = 0; i < NUM_SAMPLES; i++)
+        if (dac_idle_busy())
         {
-            dac_value[i] = dac_value2[i];
+            dac_mix_pending = TRUE;
+            dac_defer();
         }
+        else
+        {
+            dac_mix_begin();
+        }
+    }
+    dma_irq_unlock();
+}
+
+/**
+ * @brief Go back to the looping wave output, silent until the next @ref dac_play.
+ *
+ * A silent period is queued after the block being played, which breaks the ring.
+ */
+void dac_mix_stop(void)
+{
+    dma_irq_lock();
+    dac_mix_pending = FALSE; /**< Not started yet: the wave output simply goes on. */
+    if (dac_mixing)
+    {
+        dac_mixing = FALSE;
+        dac_active = dac_playing();
+        dac_wave = &dac_zone_wave[ZONE_CLEAR];
+        dac_gain = 0;
+        dac_gain_target = 0;
+        dac_queue_period();
+    }
+    dma_irq_unlock();
+}
+
+/**
+ * @brief GPDMA callback of the DAC channel.
+ *
+ * While mixing, the buffer the GPDMA has just left is refilled with the next block.
+ *
+ * Otherwise only periods queued during a ramp interrupt, and the active period when a change is deferred
+ * (@ref dac_defer); a deferred mix starts here. A queued period is fetched with the link it had
+ * before the next one was queued, so it plays twice: the interrupt of its first pass finds the idle buffer
+ * busy and is skipped, the second one renders the next step into the buffer just left. Each gain step
+ * therefore lasts two periods, and the GPDMA never reads a buffer being written.
+ */
+void dac_on_dma(uint8_t channel, uint32_t status)
+{
+    (void)channel;
+    if (!(status & DMA_STATUS_DONE))
+    {
+        return;
     }
+
+    if (dac_mixing)
+    {
+        dac_mix_render(dac_playing() ^ 1);
+    }
+    else if (dac_idle_busy())
+    {
+        return; /**< First pass of a queued period, the buffer just left is still linked. */
+    }
+    else if (dac_mix_pending)
+    {
+        dac_mix_begin();
+    }
+    else if (dac_ramping)
+    {
+        dac_queue_period();
+    }
+}
+
+/**
+ * @brief Updates the data to be converted by the DAC.
+ *
+ */
+void update_dac(void)
+{
+    dac_play(&dac_zone_wave[alarm_level]);
 }
@@ -0,0 +1,191 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleDMA.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleDMA.h"
+
+/**
+ * @file moduleDMA.c
+ * @brief Implementation of the GPDMA channel allocator, linked list item pool and interrupt dispatch.
+ */
+
+/// Linked list items handed to the channels.
+static GPDMA_LLI_Type dma_lli_pool[DMA_LLI_POOL];
+
+/// Channel owning each pool item, DMA_NONE when free.
+static uint8_t dma_lli_owner[DMA_LLI_POOL];
+
+/// TRUE for every reserved channel.
+static uint8_t dma_reserved[DMA_CHANNELS];
+
+/// Callback of every channel.
+static dma_callback_t dma_callbacks[DMA_CHANNELS];
+
+/// Sections masking the GPDMA interrupt currently open, see @ref dma_irq_lock.
+static volatile uint8_t dma_lock_depth = 0;
+
+/**
+ * @brief Reset the GPDMA controller and the service state, and enable its interrupt.
+ *
+ * This is the only call to `GPDMA_Init()`, which disables every channel.
+ */
+void configure_dma(void)
+{
+    for (uint8_t i = 0; i < DMA_LLI_POOL; i++)
+    {
+        dma_lli_owner[i] = DMA_NONE;
+    }
+    for (uint8_t ch = 0; ch < DMA_CHANNELS; ch++)
+    {
+        dma_reserved[ch] = FALSE;
+        dma_callbacks[ch] = NULL;
+    }
+
+    GPDMA_Init();             /**< Power the controller, disable every channel and clear every flag. */
+    NVIC_EnableIRQ(DMA_IRQn); /**< Terminal count and error interrupts of every channel. */
+}
+
+/**
+ * @brief Reserve a channel.
+ */
+uint8_t dma_channel_reserve(uint8_t priority, dma_callback_t callback)
+{
+    for (uint8_t ch = priority; ch < DMA_CHANNELS; ch++)
+    {
+        if (!dma_reserved[ch])
+        {
+            dma_reserved[ch] = TRUE;
+            dma_callbacks[ch] = callback;
+            return ch;
+        }
+    }
+    return DMA_NONE;
+}
+
+/**
+ * @brief Stop a channel and give it back, with its linked list items.
+ */
+void dma_channel_release(uint8_t channel)
+{
+    if (channel >= DMA_CHANNELS)
+    {
+        return;
+    }
+
+    GPDMA_ChannelCmd(channel, DISABLE);
+    dma_reserved[channel] = FALSE;
+    dma_callbacks[channel] = NULL;
+    for (uint8_t i = 0; i < DMA_LLI_POOL; i++)
+    {
+        if (dma_lli_owner[i] == channel)
+        {
+            dma_lli_owner[i] = DMA_NONE;
+        }
+    }
+}
+
+/**
+ * @brief Take consecutive linked list items from the pool.
+ *
+ * First fit over the pool, which is a handful of items.
+ */
+GPDMA_LLI_Type* dma_lli_alloc(uint8_t channel, uint8_t count)
+{
+    uint8_t run = 0; /**< Free items found in a row. */
+
+    for (uint8_t i = 0; i < DMA_LLI_POOL && count > 0; i++)
+    {
+        run = (dma_lli_owner[i] == DMA_NONE) ? run + 1 : 0;
+        if (run == count)
+        {
+            uint8_t first = i + 1 - count;
+            for (uint8_t j = first; j <= i; j++)
+            {
+                dma_lli_owner[j] = channel;
+            }
+            return &dma_lli_pool[first];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Registers of a channel.
+ *
+ * The channel register blocks are 0x20 bytes apart.
+ */
+LPC_GPDMACH_TypeDef* dma_channel_regs(uint8_t channel)
+{
+    return (LPC_GPDMACH_TypeDef*)(LPC_GPDMACH0_BASE + (uint32_t)channel * (LPC_GPDMACH1_BASE - LPC_GPDMACH0_BASE));
+}
+
+/**
+ * @brief Mask the GPDMA interrupt, nest-safe.
+ *
+ * The depth is a read-modify-write shared by every priority, so it is updated with the interrupts masked;
+ * the previous mask state is restored afterwards, as in `event_raise`. The barriers make the line masked
+ * before the caller touches the shared state.
+ */
+void dma_irq_lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (dma_lock_depth++ == 0)
+    {
+        NVIC_DisableIRQ(DMA_IRQn);
+        __DSB();
+        __ISB();
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief End a section started by @ref dma_irq_lock.
+ */
+void dma_irq_unlock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (--dma_lock_depth == 0)
+    {
+        NVIC_EnableIRQ(DMA_IRQn);
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief GPDMA Interrupt Handler.
+ *
+ * Both status registers are read once; flags are cleared before the callback runs, so a callback that
+ * restarts its channel does not lose the next interrupt.
+ */
+void DMA_IRQHandler(void)
+{
+    uint32_t done = LPC_GPDMA->DMACIntTCStat;
+    uint32_t error = LPC_GPDMA->DMACIntErrStat;
+
+    LPC_GPDMA->DMACIntTCClear = done;
+    LPC_GPDMA->DMACIntErrClr = error;
+
+    for (uint8_t ch = 0; ch < DMA_CHANNELS; ch++)
+    {
+        uint32_t status = ((done >> ch) & 1) * DMA_STATUS_DONE | ((error >> ch) & 1) * DMA_STATUS_ERROR;
+
+        if (status != 0 && dma_callbacks[ch] != NULL)
+        {
+            dma_callbacks[ch](ch, status);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleDistance.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleDistance.h"
+
+/**
+ * @file moduleDistance.c
+ * @brief Implementation of the counts to millimetres linearization.
+ */
+
+/// Calibration points, in millimetres, one every 2^DISTANCE_STEP_LOG counts.
+static const uint16_t distance_points[] = {DISTANCE_CALIBRATION};
+
+_Static_assert(sizeof(distance_points) / sizeof(distance_points[0]) == DISTANCE_POINTS,
+               "DISTANCE_CALIBRATION needs one point every 2^DISTANCE_STEP_LOG counts, both ends included");
+
+/**
+ * @brief Convert a 12-bit reading into millimetres.
+ *
+ * The upper bits select the segment and the lower bits are the position inside it, so the interpolation
+ * weight is already scaled by 2^DISTANCE_STEP_LOG and a shift replaces the division.
+ */
+uint16_t distance_mm_from_counts(uint16_t counts)
+{
+    const uint16_t* point;
+    int32_t offset;
+
+    if (counts >= DISTANCE_FULL_SCALE)
+    {
+        counts = DISTANCE_FULL_SCALE - 1;
+    }
+
+    point = &distance_points[counts >> DISTANCE_STEP_LOG];
+    offset = counts & ((1 << DISTANCE_STEP_LOG) - 1);
+
+    return (uint16_t)(point[0] + ((((int32_t)point[1] - point[0]) * offset) >> DISTANCE_STEP_LOG));
+}
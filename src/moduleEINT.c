@@ -46,7 +46,9 @@ void configure_external_interrupt(void)
  * @brief External interrupt handler EINT0.
  *
  * Toggles between enabling and disabling the system when the interrupt is triggered.
- * It also controls the status of the LEDs and the DAC.
+ * It also controls the status of the LEDs; the buzzer is faded out or back in from PendSV
+ * (`EVENT_ENABLE`), instead of cutting the DAC output with a click. SysTick keeps running while
+ * disabled, as it also paces the UART and the telemetry; only its LED blinking follows `habilitar`.
  */
 
 void EINT0_IRQHandler(void)
@@ -55,14 +57,12 @@ void EINT0_IRQHandler(void)
     if (habilitar == TRUE)
     {
         habilitar = FALSE;
-        SYSTICK_IntCmd(DISABLE);
         GPIO_ClearValue(PINSEL_PORT_0, GREEN_LED_PIN);
         GPIO_ClearValue(PINSEL_PORT_0, RED_LED_PIN);
-        DAC_UpdateValue(LPC_DAC, 0);
     }
     else
     {
         habilitar = TRUE;
-        SYSTICK_IntCmd(ENABLE);
     }
+    event_raise(EVENT_ENABLE);
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleEvent.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleEvent.h"
+
+/**
+ * @file moduleEvent.c
+ * @brief Implementation of the deferred event notification.
+ */
+
+/// Events raised and not yet dispatched.
+static volatile uint32_t event_pending = 0;
+
+/// Events of interest of each subscription.
+static uint32_t event_masks[EVENT_MAX_HANDLERS];
+
+/// Handler of each subscription.
+static event_handler_t event_handlers[EVENT_MAX_HANDLERS];
+
+/// Number of subscriptions in use.
+static uint8_t event_count = 0;
+
+/**
+ * @brief Set the PendSV priority and clear the subscriptions.
+ */
+void configure_events(void)
+{
+    event_pending = 0;
+    event_count = 0;
+    NVIC_SetPriority(PendSV_IRQn, EVENT_PRIORITY); /**< Below every peripheral interrupt. */
+}
+
+/**
+ * @brief Subscribe a handler to a set of events.
+ */
+int event_subscribe(uint32_t events, event_handler_t handler)
+{
+    if (event_count >= EVENT_MAX_HANDLERS)
+    {
+        return -1;
+    }
+
+    event_masks[event_count] = events;
+    event_handlers[event_count] = handler;
+    event_count++;
+    return 0;
+}
+
+/**
+ * @brief Raise events, from an interrupt handler or from thread mode.
+ *
+ * Handlers of different priorities may raise events at the same time, so the read-modify-write of the
+ * pending mask is done with the interrupts masked; the previous mask state is restored afterwards.
+ */
+void event_raise(uint32_t events)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    event_pending |= events;
+    __set_PRIMASK(primask);
+
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk; /**< Run PendSV when nothing more urgent is running. */
+}
+
+/**
+ * @brief PendSV exception handler.
+ *
+ * Events raised while the handlers run pend PendSV again and are dispatched on the next pass.
+ */
+void PendSV_Handler(void)
+{
+    uint32_t events;
+
+    __disable_irq();
+    events = event_pending;
+    event_pending = 0;
+    __enable_irq();
+
+    for (uint8_t i = 0; i < event_count; i++)
+    {
+        if (events & event_masks[i])
+        {
+            event_handlers[i](events & event_masks[i]);
+        }
+    }
+}
@@ -0,0 +1,144 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleFormat.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleFormat.h"
+
+/**
+ * @file moduleFormat.c
+ * @brief Implementation of the integer to text conversions.
+ */
+
+/// Hexadecimal digits.
+static const char format_hex_digits[16] = "0123456789ABCDEF";
+
+/// Powers of ten used by the fixed-point conversion.
+static const uint32_t format_pow10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+                                          1000000000};
+
+/**
+ * @brief Unsigned decimal.
+ *
+ * The digits come out least significant first into a scratch array and are copied in order; one hardware
+ * division per digit on the Cortex-M3.
+ */
+size_t format_unsigned(char* out, uint32_t value)
+{
+    char digits[FORMAT_UNSIGNED_MAX];
+    size_t count = 0;
+    size_t i;
+
+    do
+    {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+
+    for (i = 0; i < count; i++)
+    {
+        out[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+
+/**
+ * @brief Signed decimal, with a leading '-' for negative values.
+ *
+ * The magnitude is taken in unsigned arithmetic, so INT32_MIN does not overflow.
+ */
+size_t format_signed(char* out, int32_t value)
+{
+    if (value < 0)
+    {
+        out[0] = '-';
+        return 1 + format_unsigned(out + 1, 0u - (uint32_t)value);
+    }
+    return format_unsigned(out, (uint32_t)value);
+}
+
+/**
+ * @brief Uppercase hexadecimal, without prefix.
+ */
+size_t format_hex(char* out, uint32_t value, uint8_t digits)
+{
+    size_t count = 1;
+    size_t i;
+
+    while (count < FORMAT_HEX_MAX && (value >> (4 * count)) != 0)
+    {
+        count++;
+    }
+    if (digits > FORMAT_HEX_MAX)
+    {
+        digits = FORMAT_HEX_MAX;
+    }
+    if (count < digits)
+    {
+        count = digits;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        out[i] = format_hex_digits[(value >> (4 * (count - 1 - i))) & 0xF];
+    }
+    return count;
+}
+
+/**
+ * @brief Fixed-point decimal.
+ *
+ * The integer part and the fraction are converted separately; the fraction is zero padded to `decimals`
+ * digits.
+ */
+size_t format_fixed(char* out, int32_t value, uint8_t decimals)
+{
+    uint32_t magnitude = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;
+    uint32_t fraction;
+    size_t count = 0;
+    uint8_t i;
+
+    if (decimals == 0 || decimals > 9)
+    {
+        return format_signed(out, value);
+    }
+
+    if (value < 0)
+    {
+        out[count++] = '-';
+    }
+    count += format_unsigned(out + count, magnitude / format_pow10[decimals]);
+    out[count++] = '.';
+
+    fraction = magnitude % format_pow10[decimals];
+    for (i = decimals; i > 0; i--)
+    {
+        out[count + i - 1] = (char)('0' + fraction % 10);
+        fraction /= 10;
+    }
+    return count + decimals;
+}
+
+/**
+ * @brief Copy a string, without its NUL.
+ */
+size_t format_text(char* out, const char* text)
+{
+    size_t count = 0;
+
+    while (text[count] != '\0')
+    {
+        out[count] = text[count];
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,153 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleMixer.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleMixer.h"
+
+/**
+ * @file moduleMixer.c
+ * @brief Implementation of the block mixer.
+ */
+
+/**
+ * @brief Prepare a mixer with every voice muted.
+ */
+void mixer_init(mixer_t* mixer, const uint16_t* table, uint8_t points_log2, uint16_t midscale,
+                uint32_t sample_rate)
+{
+    for (uint8_t i = 0; i < MIXER_VOICES; i++)
+    {
+        mixer_voice_t* v = &mixer->voice[i];
+        v->phase = 0;
+        v->phase_step = 0;
+        v->on_samples = 1;
+        v->off_samples = 0;
+        v->position = 0;
+        v->gain = 0;
+        v->level = 0;
+    }
+
+    mixer->table = table;
+    mixer->index_shift = (uint8_t)(32 - points_log2);
+    mixer->midscale = midscale;
+    mixer->sample_rate = sample_rate;
+    mixer->blocks = 0;
+    mixer->clipped = 0;
+}
+
+/**
+ * @brief Set the tone of a voice.
+ *
+ * The 64-bit division only runs here, when the tone changes, never per sample.
+ */
+void mixer_set_tone(mixer_t* mixer, uint8_t voice, uint32_t frequency_hz, uint16_t gain)
+{
+    mixer_voice_t* v = &mixer->voice[voice];
+
+    v->phase_step = (uint32_t)(((uint64_t)frequency_hz << 32) / mixer->sample_rate);
+    v->gain = (frequency_hz == 0) ? 0 : gain;
+}
+
+/**
+ * @brief Set the beep cadence of a voice from a distance (see moduleCadence).
+ *
+ * The position inside the cycle is kept, so the beep in progress is not restarted.
+ */
+void mixer_set_distance(mixer_t* mixer, uint8_t voice, uint16_t distance_mm)
+{
+    mixer_voice_t* v = &mixer->voice[voice];
+    cadence_t cadence;
+    uint32_t per_ms = mixer->sample_rate / 1000; /**< Samples per millisecond. */
+
+    cadence_from_distance(distance_mm, &cadence);
+    v->on_samples = (cadence.on_us / 1000) * per_ms;
+    v->off_samples = (cadence.off_us / 1000) * per_ms;
+    if (v->position >= v->on_samples + v->off_samples)
+    {
+        v->position = 0;
+    }
+}
+
+/**
+ * @brief Render one block of the mixed stream.
+ *
+ * Voices are accumulated one after the other into a signed block, so each voice keeps its phase and step
+ * in registers for the whole block; the sum is then offset to midscale and saturated in a single pass.
+ */
+void mixer_render(mixer_t* mixer, volatile uint32_t* out, size_t count, uint8_t shift)
+{
+    int32_t acc[MIXER_MAX_BLOCK];
+    const int32_t top = 2 * (int32_t)mixer->midscale - 1;
+    const uint8_t index_shift = mixer->index_shift;
+
+    if (count > MIXER_MAX_BLOCK)
+    {
+        count = MIXER_MAX_BLOCK;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        acc[i] = 0;
+    }
+
+    for (uint8_t n = 0; n < MIXER_VOICES; n++)
+    {
+        mixer_voice_t* v = &mixer->voice[n];
+        uint8_t gate = (v->off_samples == 0) || (v->position < v->on_samples);
+        uint16_t target = gate ? v->gain : 0;
+
+        // Amplitude ramp, one step per block
+        if (v->level < target)
+        {
+            v->level = (target - v->level > MIXER_RAMP_STEP) ? v->level + MIXER_RAMP_STEP : target;
+        }
+        else if (v->level > target)
+        {
+            v->level = (v->level - target > MIXER_RAMP_STEP) ? v->level - MIXER_RAMP_STEP : target;
+        }
+
+        // Cadence, one check per block
+        v->position += (uint32_t)count;
+        if (v->position >= v->on_samples + v->off_samples)
+        {
+            v->position = 0;
+        }
+
+        if (v->level == 0)
+        {
+            continue; /**< Muted or silent voices cost nothing. */
+        }
+
+        uint32_t phase = v->phase;
+        const uint32_t step = v->phase_step;
+        const int32_t level = v->level;
+        for (size_t i = 0; i < count; i++)
+        {
+            acc[i] += ((int32_t)mixer->table[phase >> index_shift] - mixer->midscale) * level;
+            phase += step;
+        }
+        v->phase = phase;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t sample = mixer->midscale + (acc[i] >> MIXER_GAIN_Q);
+
+        if (sample > top || sample < 0)
+        {
+            sample = (sample < 0) ? 0 : top;
+            mixer->clipped++;
+        }
+        out[i] = (uint32_t)sample << shift;
+    }
+    mixer->blocks++;
+}
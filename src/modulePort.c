@@ -13,6 +13,8 @@
  * All rights reserved.
  ****************************************************************************/
 #include "modulePort.h"
+#include "moduleADC.h"
+#include "moduleBuzzer.h"
 
 /**
  * @file modulePort.c
@@ -23,6 +25,20 @@
  *
  */
 
+/**
+ * @brief Pin of every AD0 channel (LPC1769 user manual, table 79).
+ */
+const adc_pin_t adc_channel_pins[8] = {
+    {PINSEL_PORT_0, PINSEL_PIN_23, PINSEL_FUNC_1}, // AD0.0
+    {PINSEL_PORT_0, PINSEL_PIN_24, PINSEL_FUNC_1}, // AD0.1
+    {PINSEL_PORT_0, PINSEL_PIN_25, PINSEL_FUNC_1}, // AD0.2
+    {PINSEL_PORT_0, PINSEL_PIN_26, PINSEL_FUNC_1}, // AD0.3 (shared with AOUT)
+    {PINSEL_PORT_1, PINSEL_PIN_30, PINSEL_FUNC_3}, // AD0.4
+    {PINSEL_PORT_1, PINSEL_PIN_31, PINSEL_FUNC_3}, // AD0.5
+    {PINSEL_PORT_0, PINSEL_PIN_3, PINSEL_FUNC_2},  // AD0.6 (shared with RXD0)
+    {PINSEL_PORT_0, PINSEL_PIN_2, PINSEL_FUNC_2}   // AD0.7 (shared with TXD0)
+};
+
 /**
  * @brief Configure system pins.
  *
@@ -30,8 +46,8 @@
  * - External switch (EINT0)
  * - LEDs (green y red)
  * - UART (TX y RX)
- * - ADC (Analog to Digital Conversion Input)
- * - DAC (Digital to Analog Conversion Output)
+ * - ADC (Analog to Digital Conversion Inputs, one per channel in `ADC_SCAN_CHANNELS`)
+ * - Buzzer (DAC output or PWM1.1, depending on `BUZZER_BACKEND`)
  *
  * Configure the pins with the corresponding functions, as well as resistance modes (pull-up, pull-down, etc.)
  * and input/output addresses.
@@ -72,13 +88,30 @@ void configure_port(void)
     pin_cfg.Funcnum = PINSEL_FUNC_1; /**< UART RX function */
     PINSEL_ConfigPin(&pin_cfg);      /**< Set the configuration for UART RX */
 
-    // ADC pin configuration (P0.23)
-    pin_cfg.Pinnum = PINSEL_PIN_23;  /**< ADC pin */
-    pin_cfg.Funcnum = PINSEL_FUNC_1; /**< ADC function */
-    PINSEL_ConfigPin(&pin_cfg);      /**< Set the configuration for ADC */
+    // ADC pin configuration, one pin per scanned channel (channel 0 is P0.23)
+    pin_cfg.Pinmode = PINSEL_PINMODE_TRISTATE; /**< No pull resistor on analog inputs */
+    for (uint8_t ch = 0; ch < ADC_MAX_CHANNELS; ch++)
+    {
+        if (ADC_SCAN_CHANNELS & (1 << ch))
+        {
+            pin_cfg.Portnum = adc_channel_pins[ch].port;     /**< Port of the channel */
+            pin_cfg.Pinnum = adc_channel_pins[ch].pin;       /**< ADC pin */
+            pin_cfg.Funcnum = adc_channel_pins[ch].function; /**< ADC function */
+            PINSEL_ConfigPin(&pin_cfg);                      /**< Set the configuration for ADC */
+        }
+    }
 
+#if BUZZER_BACKEND == BUZZER_BACKEND_PWM
+    // PWM1.1 pin configuration (P2.0)
+    pin_cfg.Portnum = PINSEL_PORT_2; /**< Port where the pin is configured */
+    pin_cfg.Pinnum = PINSEL_PIN_0;   /**< PWM1.1 pin */
+    pin_cfg.Funcnum = PINSEL_FUNC_1; /**< PWM1.1 function */
+    PINSEL_ConfigPin(&pin_cfg);      /**< Set the configuration for the buzzer */
+#else
     // DAC pin configuration (P0.26)
+    pin_cfg.Portnum = PINSEL_PORT_0; /**< Port where the pin is configured */
     pin_cfg.Pinnum = PINSEL_PIN_26;  /**< DAC pin */
     pin_cfg.Funcnum = PINSEL_FUNC_2; /**< DAC function */
     PINSEL_ConfigPin(&pin_cfg);      /**< Set the configuration for DAC */
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,351 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleProtocol.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleProtocol.h"
+
+/**
+ * @file moduleProtocol.c
+ * @brief Implementation of the COBS framing, the CRC-16 and the payload layouts.
+ */
+
+/**
+ * @brief COBS encoder writing one byte at a time.
+ *
+ * Lets a frame be encoded straight from its header, payload and CRC, without assembling them first.
+ */
+typedef struct
+{
+    uint8_t* out;   ///< Destination.
+    size_t code_at; ///< Position of the code byte of the current block.
+    size_t pos;     ///< Next free position.
+    uint8_t code;   ///< Current block length plus one.
+} cobs_writer_t;
+
+/// CRC-16/CCITT-FALSE of every nibble, processed four bits at a time.
+static const uint16_t crc16_nibble[16] = {0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+                                          0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF};
+
+static void cobs_begin(cobs_writer_t* writer, uint8_t* out)
+{
+    writer->out = out;
+    writer->code_at = 0;
+    writer->pos = 1;
+    writer->code = 1;
+}
+
+/**
+ * @brief Close the current block and open the next one.
+ */
+static void cobs_close_block(cobs_writer_t* writer)
+{
+    writer->out[writer->code_at] = writer->code;
+    writer->code_at = writer->pos++;
+    writer->code = 1;
+}
+
+static void cobs_put(cobs_writer_t* writer, uint8_t byte)
+{
+    if (byte == 0)
+    {
+        cobs_close_block(writer);
+        return;
+    }
+
+    writer->out[writer->pos++] = byte;
+    if (++writer->code == 0xFF)
+    {
+        cobs_close_block(writer); /**< 254 data bytes: a full block, without an implicit zero. */
+    }
+}
+
+static size_t cobs_end(cobs_writer_t* writer)
+{
+    writer->out[writer->code_at] = writer->code;
+    return writer->pos;
+}
+
+static uint8_t* put_u16(uint8_t* out, uint16_t value)
+{
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    return out + 2;
+}
+
+static uint8_t* put_u32(uint8_t* out, uint32_t value)
+{
+    out = put_u16(out, (uint16_t)value);
+    return put_u16(out, (uint16_t)(value >> 16));
+}
+
+static uint16_t get_u16(const uint8_t* in)
+{
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t* in)
+{
+    return get_u16(in) | ((uint32_t)get_u16(in + 2) << 16);
+}
+
+/**
+ * @brief Update a CRC-16/CCITT-FALSE.
+ *
+ * A 16-entry table, two lookups per byte: far smaller than the usual 256-entry table and still without a
+ * loop over the bits.
+ */
+uint16_t protocol_crc16(uint16_t crc, const uint8_t* data, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = (uint16_t)((crc << 4) ^ crc16_nibble[(crc >> 12) ^ (data[i] >> 4)]);
+        crc = (uint16_t)((crc << 4) ^ crc16_nibble[(crc >> 12) ^ (data[i] & 0x0F)]);
+    }
+    return crc;
+}
+
+/**
+ * @brief COBS encode a block, without delimiter.
+ */
+size_t cobs_encode(const uint8_t* data, size_t length, uint8_t* out)
+{
+    cobs_writer_t writer;
+
+    cobs_begin(&writer, out);
+    for (size_t i = 0; i < length; i++)
+    {
+        cobs_put(&writer, data[i]);
+    }
+    return cobs_end(&writer);
+}
+
+/**
+ * @brief COBS decode a block, without delimiter.
+ *
+ * The write position never passes the read position, so the block can be decoded in place.
+ */
+int cobs_decode(const uint8_t* data, size_t length, uint8_t* out)
+{
+    size_t read = 0;
+    size_t written = 0;
+
+    while (read < length)
+    {
+        uint8_t code = data[read++];
+        if (code == 0 || read + code - 1 > length)
+        {
+            return -1;
+        }
+
+        for (uint8_t i = 1; i < code; i++)
+        {
+            uint8_t byte = data[read++];
+            if (byte == 0)
+            {
+                return -1;
+            }
+            out[written++] = byte;
+        }
+
+        if (code != 0xFF && read < length)
+        {
+            out[written++] = 0;
+        }
+    }
+    return (int)written;
+}
+
+/**
+ * @brief Build a complete frame.
+ *
+ * The header, the payload and the CRC are fed to the COBS encoder as they are produced.
+ */
+size_t protocol_encode(const protocol_header_t* header, const uint8_t* payload, size_t length, uint8_t* frame)
+{
+    uint8_t head[PROTOCOL_HEADER_SIZE];
+    uint16_t crc;
+    cobs_writer_t writer;
+    size_t size;
+
+    if (length > PROTOCOL_MAX_PAYLOAD)
+    {
+        return 0;
+    }
+
+    head[0] = header->type;
+    head[1] = header->sequence;
+    put_u32(&head[2], header->timestamp);
+    crc = protocol_crc16(PROTOCOL_CRC_INIT, head, PROTOCOL_HEADER_SIZE);
+    crc = protocol_crc16(crc, payload, length);
+
+    cobs_begin(&writer, frame);
+    for (size_t i = 0; i < PROTOCOL_HEADER_SIZE; i++)
+    {
+        cobs_put(&writer, head[i]);
+    }
+    for (size_t i = 0; i < length; i++)
+    {
+        cobs_put(&writer, payload[i]);
+    }
+    cobs_put(&writer, (uint8_t)crc);
+    cobs_put(&writer, (uint8_t)(crc >> 8));
+
+    size = cobs_end(&writer);
+    frame[size++] = PROTOCOL_DELIMITER;
+    return size;
+}
+
+/**
+ * @brief Prepare a stream decoder.
+ */
+void protocol_decoder_init(protocol_decoder_t* decoder)
+{
+    decoder->fill = 0;
+    decoder->overflow = 0;
+    decoder->frames = 0;
+    decoder->crc_errors = 0;
+    decoder->framing_errors = 0;
+}
+
+/**
+ * @brief Feed one received byte to a stream decoder.
+ *
+ * Consecutive delimiters are ignored, so a sender may flush the line with zeros. A frame longer than the
+ * buffer is discarded whole at its delimiter.
+ */
+int protocol_decoder_feed(protocol_decoder_t* decoder, uint8_t byte, protocol_header_t* header,
+                          const uint8_t** payload, size_t* length)
+{
+    int decoded;
+    uint16_t crc;
+
+    if (byte != PROTOCOL_DELIMITER)
+    {
+        if (decoder->fill < sizeof(decoder->buffer))
+        {
+            decoder->buffer[decoder->fill++] = byte;
+        }
+        else
+        {
+            decoder->overflow = 1;
+        }
+        return 0;
+    }
+
+    if (decoder->fill == 0 && !decoder->overflow)
+    {
+        return 0;
+    }
+
+    decoded = decoder->overflow ? -1 : cobs_decode(decoder->buffer, decoder->fill, decoder->buffer);
+    decoder->fill = 0;
+    decoder->overflow = 0;
+    if (decoded < PROTOCOL_HEADER_SIZE + PROTOCOL_CRC_SIZE)
+    {
+        decoder->framing_errors++;
+        return 0;
+    }
+
+    crc = protocol_crc16(PROTOCOL_CRC_INIT, decoder->buffer, (size_t)decoded - PROTOCOL_CRC_SIZE);
+    if (crc != get_u16(&decoder->buffer[decoded - PROTOCOL_CRC_SIZE]))
+    {
+        decoder->crc_errors++;
+        return 0;
+    }
+
+    header->type = decoder->buffer[0];
+    header->sequence = decoder->buffer[1];
+    header->timestamp = get_u32(&decoder->buffer[2]);
+    *payload = &decoder->buffer[PROTOCOL_HEADER_SIZE];
+    *length = (size_t)decoded - PROTOCOL_HEADER_SIZE - PROTOCOL_CRC_SIZE;
+    decoder->frames++;
+    return 1;
+}
+
+/**
+ * @brief Pack a snapshot payload.
+ */
+size_t protocol_pack_snapshot(const protocol_snapshot_t* snapshot, uint8_t* out)
+{
+    out = put_u16(out, snapshot->value);
+    out = put_u16(out, snapshot->distance);
+    *out++ = snapshot->zone;
+    *out++ = snapshot->level;
+    out = put_u16(out, snapshot->closing_speed);
+    out = put_u16(out, snapshot->ttc_ms);
+    *out++ = snapshot->flags;
+    out = put_u32(out, snapshot->adc_overruns);
+    out = put_u32(out, snapshot->uart_dropped);
+    put_u16(out, snapshot->skipped);
+    return PROTOCOL_SNAPSHOT_SIZE;
+}
+
+/**
+ * @brief Unpack a snapshot payload.
+ */
+int protocol_unpack_snapshot(const uint8_t* payload, size_t length, protocol_snapshot_t* snapshot)
+{
+    if (length != PROTOCOL_SNAPSHOT_SIZE)
+    {
+        return -1;
+    }
+
+    snapshot->value = get_u16(&payload[0]);
+    snapshot->distance = get_u16(&payload[2]);
+    snapshot->zone = payload[4];
+    snapshot->level = payload[5];
+    snapshot->closing_speed = get_u16(&payload[6]);
+    snapshot->ttc_ms = get_u16(&payload[8]);
+    snapshot->flags = payload[10];
+    snapshot->adc_overruns = get_u32(&payload[11]);
+    snapshot->uart_dropped = get_u32(&payload[15]);
+    snapshot->skipped = get_u16(&payload[19]);
+    return 0;
+}
+
+/**
+ * @brief Pack a status payload.
+ */
+size_t protocol_pack_status(const protocol_status_t* status, uint8_t* out)
+{
+    out = put_u16(out, status->value);
+    out = put_u16(out, status->distance);
+    *out++ = status->zone;
+    *out++ = status->level;
+    out = put_u16(out, status->closing_speed);
+    out = put_u16(out, status->ttc_ms);
+    out = put_u32(out, status->samples);
+    put_u32(out, status->overruns);
+    return PROTOCOL_STATUS_SIZE;
+}
+
+/**
+ * @brief Unpack a status payload.
+ */
+int protocol_unpack_status(const uint8_t* payload, size_t length, protocol_status_t* status)
+{
+    if (length != PROTOCOL_STATUS_SIZE)
+    {
+        return -1;
+    }
+
+    status->value = get_u16(&payload[0]);
+    status->distance = get_u16(&payload[2]);
+    status->zone = payload[4];
+    status->level = payload[5];
+    status->closing_speed = get_u16(&payload[6]);
+    status->ttc_ms = get_u16(&payload[8]);
+    status->samples = get_u32(&payload[10]);
+    status->overruns = get_u32(&payload[14]);
+    return 0;
+}
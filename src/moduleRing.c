@@ -0,0 +1,188 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleRing.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleRing.h"
+
+/**
+ * @file moduleRing.c
+ * @brief Implementation of the single-producer/single-consumer sample and byte rings.
+ *
+ * `__sync_synchronize()` is a full memory barrier (DMB on the Cortex-M3) that also stops the compiler from
+ * moving the slot accesses across the index update.
+ */
+
+/**
+ * @brief Prepare an empty ring.
+ */
+int ring_init(sample_ring_t* ring, ring_sample_t* storage, uint32_t size)
+{
+    if (size == 0 || (size & (size - 1)) != 0)
+    {
+        return -1;
+    }
+
+    ring->head = 0;
+    ring->tail = 0;
+    ring->overruns = 0;
+    ring->mask = size - 1;
+    ring->slots = storage;
+    return 0;
+}
+
+/**
+ * @brief Append a sample (producer side).
+ *
+ * The slot is written before the new head is published, so the consumer never sees a half written sample.
+ */
+int ring_push(sample_ring_t* ring, const ring_sample_t* sample)
+{
+    uint32_t head = ring->head;
+
+    if (head - ring->tail > ring->mask)
+    {
+        ring->overruns++;
+        return -1;
+    }
+
+    ring->slots[head & ring->mask] = *sample;
+    __sync_synchronize();
+    ring->head = head + 1;
+    return 0;
+}
+
+/**
+ * @brief Take up to `max` of the oldest samples (consumer side).
+ *
+ * The slots are copied before the new tail is published, so the producer cannot reuse them while they are
+ * being read.
+ */
+size_t ring_pop_batch(sample_ring_t* ring, ring_sample_t* out, size_t max)
+{
+    uint32_t tail = ring->tail;
+    uint32_t available = ring->head - tail;
+    size_t count = (available < max) ? available : max;
+
+    __sync_synchronize(); /**< Read the slots only after the head that covers them. */
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = ring->slots[(tail + i) & ring->mask];
+    }
+    __sync_synchronize();
+    ring->tail = tail + (uint32_t)count;
+    return count;
+}
+
+/**
+ * @brief Number of samples waiting in the ring.
+ */
+uint32_t ring_count(const sample_ring_t* ring)
+{
+    return ring->head - ring->tail;
+}
+
+/**
+ * @brief Prepare an empty byte ring.
+ */
+int byte_ring_init(byte_ring_t* ring, uint8_t* storage, uint32_t size)
+{
+    if (size == 0 || (size & (size - 1)) != 0)
+    {
+        return -1;
+    }
+
+    ring->head = 0;
+    ring->tail = 0;
+    ring->dropped = 0;
+    ring->mask = size - 1;
+    ring->bytes = storage;
+    return 0;
+}
+
+/**
+ * @brief Append a block of bytes (producer side).
+ *
+ * The bytes are written before the new head is published, as in @ref ring_push.
+ */
+size_t byte_ring_write(byte_ring_t* ring, const uint8_t* data, size_t length)
+{
+    uint32_t head = ring->head;
+    uint32_t room = ring->mask + 1 - (head - ring->tail);
+
+    if (length > room)
+    {
+        ring->dropped += (uint32_t)length;
+        return 0;
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+        ring->bytes[(head + i) & ring->mask] = data[i];
+    }
+    __sync_synchronize();
+    ring->head = head + (uint32_t)length;
+    return length;
+}
+
+/**
+ * @brief Take up to `max` of the oldest bytes (consumer side).
+ */
+size_t byte_ring_read(byte_ring_t* ring, uint8_t* out, size_t max)
+{
+    uint32_t tail = ring->tail;
+    uint32_t available = ring->head - tail;
+    size_t count = (available < max) ? available : max;
+
+    __sync_synchronize(); /**< Read the bytes only after the head that covers them. */
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = ring->bytes[(tail + i) & ring->mask];
+    }
+    __sync_synchronize();
+    ring->tail = tail + (uint32_t)count;
+    return count;
+}
+
+/**
+ * @brief Locate the oldest bytes without taking them (consumer side).
+ *
+ * The run stops at the end of the storage; the bytes that wrapped around come with the next peek.
+ */
+size_t byte_ring_peek(const byte_ring_t* ring, const uint8_t** data)
+{
+    uint32_t tail = ring->tail;
+    uint32_t available = ring->head - tail;
+    uint32_t offset = tail & ring->mask;
+    uint32_t to_end = ring->mask + 1 - offset;
+
+    __sync_synchronize(); /**< The caller reads the bytes only after the head that covers them. */
+    *data = &ring->bytes[offset];
+    return (available < to_end) ? available : to_end;
+}
+
+/**
+ * @brief Release bytes located with @ref byte_ring_peek (consumer side).
+ */
+void byte_ring_skip(byte_ring_t* ring, size_t count)
+{
+    __sync_synchronize(); /**< Done with the bytes before the producer may reuse them. */
+    ring->tail += (uint32_t)count;
+}
+
+/**
+ * @brief Number of bytes waiting in the ring.
+ */
+uint32_t byte_ring_count(const byte_ring_t* ring)
+{
+    return ring->head - ring->tail;
+}
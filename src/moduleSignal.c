@@ -0,0 +1,104 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleSignal.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleSignal.h"
+
+/**
+ * @file moduleSignal.c
+ * @brief Implementation of the hardware-independent sample block processing.
+ */
+
+/**
+ * @brief Unpack raw ADC data register words into 12-bit samples.
+ *
+ * Each word holds the result in bits 15:4, the channel in bits 26:24 and the DONE/OVERRUN flags on top;
+ * only the result is kept.
+ */
+void signal_unpack_block(const volatile uint32_t* words, uint16_t* samples, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        samples[i] = SIGNAL_RESULT(words[i]);
+    }
+}
+
+/**
+ * @brief Prepare a decimator with an empty window.
+ */
+void signal_decimator_init(signal_decimator_t* dec, uint8_t log2_ratio)
+{
+    dec->sum = 0;
+    dec->fill = 0;
+    dec->log2_ratio = (log2_ratio > SIGNAL_MAX_LOG2) ? SIGNAL_MAX_LOG2 : log2_ratio;
+}
+
+/**
+ * @brief Feed one sample to a decimator.
+ */
+int signal_decimate(signal_decimator_t* dec, uint16_t sample, uint16_t* out)
+{
+    dec->sum += sample;
+    dec->fill++;
+
+    if (dec->fill < (1u << dec->log2_ratio))
+    {
+        return 0;
+    }
+
+    *out = (uint16_t)(dec->sum >> dec->log2_ratio);
+    dec->sum = 0;
+    dec->fill = 0;
+    return 1;
+}
+
+/**
+ * @brief Feed a block of samples to a decimator.
+ *
+ * The inner loop only accumulates; the window length is checked once per output instead of once per
+ * sample, which keeps the per-sample cost at one load and one addition.
+ */
+size_t signal_decimate_block(signal_decimator_t* dec, const uint16_t* samples, size_t count, uint16_t* out)
+{
+    const uint16_t ratio = (uint16_t)(1u << dec->log2_ratio);
+    uint32_t sum = dec->sum;
+    uint16_t fill = dec->fill;
+    size_t produced = 0;
+    size_t i = 0;
+
+    while (i < count)
+    {
+        size_t end = i + (ratio - fill); /**< Index that closes the current window. */
+        if (end > count)
+        {
+            end = count;
+        }
+
+        fill += (uint16_t)(end - i);
+        for (; i < end; i++)
+        {
+            sum += samples[i];
+        }
+
+        if (fill == ratio)
+        {
+            out[produced++] = (uint16_t)(sum >> dec->log2_ratio); /**< Never ahead of the input index. */
+            sum = 0;
+            fill = 0;
+        }
+    }
+
+    dec->sum = sum;
+    dec->fill = fill;
+    return produced;
+}
@@ -13,6 +13,8 @@
  * All rights reserved.
  ****************************************************************************/
 #include "moduleSystick.h"
+#include "moduleEINT.h"
+#include "moduleTelemetry.h"
 
 /**
  * @file moduleSystick.c
@@ -22,10 +24,18 @@
  */
 
 // Global variables
-volatile uint16_t red_led_counter = MAX_RED_LED_COUNTER;     ///< Red LED change counter
-volatile uint16_t green_led_counter = MAX_GREEN_LED_COUNTER; ///< Green LED change counter
-volatile uint8_t toggle = MAX_TOGGLE;                        ///< Toggle state variable
-volatile uint8_t reverse_flag = 1;                           ///< Reverse mode flag (TRUE by default)
+volatile uint16_t led_counter = MAX_RED_LED_COUNTER; ///< SysTick periods left until the next LED toggle
+volatile uint8_t proximity_zone = ZONE_WARNING;      ///< Current proximity zone (near by default)
+volatile uint8_t alarm_level = ZONE_WARNING;         ///< Zone the alarm acts as
+
+/// LED toggle period of each alarm level, in SysTick periods.
+static const uint16_t zone_led_ticks[ZONE_COUNT] = ZONE_LED_TICKS;
+
+/// LED blinking in the current alarm level.
+static volatile uint32_t led_pin = GREEN_LED_PIN;
+
+/// Toggle period of the LED in the current alarm level.
+static volatile uint16_t led_period = MAX_GREEN_LED_COUNTER;
 
 /**
  * @brief Set the SysTick timer.
@@ -45,91 +55,75 @@ void configure_systick(void)
  * @brief SysTick Interrupt Handler.
  *
  * This handler performs the following tasks:
- * - Change the state of the LEDs according to the state of `reverse_flag`.
+ * - Blink the LED selected by the last zone change while the system is enabled; the zone itself is not
+ *   polled here.
+ * - Signal the telemetry batches and snapshots.
+ * - Pace the UART line rate changes and the auto-baud time-out.
  * - Reset the SysTick interrupt flag.
  */
 void SysTick_Handler(void)
 {
-    // Toggle LEDs based on reverse_flag status
-    if (reverse_flag == TRUE)
+    if (habilitar)
     {
-        green_led(); // Green LED for reverse mode
-    }
-    else
-    {
-        red_led(); // Red LED for reverse mode
+        led_blink();
     }
+    telemetry_tick();
+    uart_tick();
 
     // Clear SysTick flag
     SYSTICK_ClearCounterFlag();
 }
 
 /**
- * @brief Change the state of the green LED.
+ * @brief Select the LED and blink period of an alarm level.
  *
- * This function changes the state of the green LED, alternating between on and off based on the toggle counter.
+ * A shorter period takes effect right away instead of after the current, longer, count.
  */
-void green_led(void)
+void led_select(uint8_t level)
 {
-    GPIO_ClearValue(PINSEL_PORT_0, RED_LED_PIN);
+    uint32_t pin = (level >= ZONE_WARNING) ? GREEN_LED_PIN : RED_LED_PIN;
 
-    if (green_led_counter > 0)
-    {
-        green_led_counter--;
-    }
+    GPIO_ClearValue(PINSEL_PORT_0, (pin == GREEN_LED_PIN) ? RED_LED_PIN : GREEN_LED_PIN);
 
-    if (green_led_counter == 0)
+    led_pin = pin;
+    led_period = zone_led_ticks[level];
+    if (led_counter > led_period)
     {
-        if (GPIO_ReadValue(PINSEL_PORT_0) & GREEN_LED_PIN)
-        {
-            GPIO_ClearValue(PINSEL_PORT_0, GREEN_LED_PIN);
-        }
-        else
-        {
-            GPIO_SetValue(PINSEL_PORT_0, GREEN_LED_PIN);
-        }
-        green_led_counter = MAX_GREEN_LED_COUNTER;
-        update_dac();
-        toggle--;
-    }
-
-    if (toggle == 0)
-    {
-        toggle = MAX_TOGGLE;
+        led_counter = led_period;
     }
 }
 
 /**
- * @brief Change the state of the red LED.
+ * @brief Change the state of the selected LED.
  *
- * This feature changes the state of the red LED, alternating between on and off based on the toggle counter.
+ * This function toggles the selected LED every `led_period` SysTick periods.
  */
-void red_led(void)
+void led_blink(void)
 {
-    GPIO_ClearValue(PINSEL_PORT_0, GREEN_LED_PIN);
-
-    if (red_led_counter > 0)
+    if (led_counter > 0)
     {
-        red_led_counter--;
+        led_counter--;
     }
 
-    if (red_led_counter == 0)
+    if (led_counter == 0)
     {
-        if (GPIO_ReadValue(PINSEL_PORT_0) & RED_LED_PIN)
+        if (GPIO_ReadValue(PINSEL_PORT_0) & led_pin)
         {
-            GPIO_ClearValue(PINSEL_PORT_0, RED_LED_PIN);
+            GPIO_ClearValue(PINSEL_PORT_0, led_pin);
         }
         else
         {
-            GPIO_SetValue(PINSEL_PORT_0, RED_LED_PIN);
+            GPIO_SetValue(PINSEL_PORT_0, led_pin);
         }
-        red_led_counter = MAX_RED_LED_COUNTER;
-        update_dac();
-        toggle--;
+        led_counter = led_period;
     }
+}
 
-    if (toggle == 0)
-    {
-        toggle = MAX_TOGGLE;
-    }
-}
\ No newline at end of file
+/**
+ * @brief Zone change consumer of the LEDs.
+ */
+void led_on_zone_change(uint32_t events)
+{
+    (void)events;
+    led_select(alarm_level);
+}
@@ -0,0 +1,260 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleTelemetry.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleTelemetry.h"
+
+/**
+ * @file moduleTelemetry.c
+ * @brief Implementation of the telemetry batches, snapshots and of their frames.
+ */
+
+#define TELEMETRY_COLLECT_CHUNK 16 ///< Samples popped from adc_ring at a time.
+
+volatile uint16_t telemetry_skipped = 0;
+volatile uint16_t telemetry_period = TELEMETRY_PERIOD_TICKS;
+batch_t telemetry_batch;
+uint16_t telemetry_batch_age_ms = TELEMETRY_BATCH_AGE_MS;
+uint32_t telemetry_samples = 0;
+
+/// Frame buffers, one can be on the wire while the other is built.
+static uint8_t telemetry_frames[2][TELEMETRY_FRAME_MAX];
+
+/// Buffer the next frame is built in.
+static uint8_t telemetry_next = 0;
+
+/// SysTick periods left until the next snapshot.
+static uint16_t telemetry_countdown = TELEMETRY_PERIOD_TICKS;
+
+/// SysTick periods so far, wraps; written by @ref telemetry_tick only.
+static volatile uint8_t telemetry_ticks = 0;
+
+/// Value of @ref telemetry_ticks at the last snapshot countdown step, written by PendSV only.
+static uint8_t telemetry_ticks_seen = 0;
+
+/**
+ * @brief Reset the counters, the batch and the tick divider.
+ */
+void configure_telemetry(void)
+{
+    telemetry_skipped = 0;
+    telemetry_next = 0;
+    telemetry_period = TELEMETRY_PERIOD_TICKS;
+    telemetry_countdown = TELEMETRY_PERIOD_TICKS;
+    telemetry_ticks_seen = telemetry_ticks;
+    telemetry_batch_age_ms = TELEMETRY_BATCH_AGE_MS;
+    telemetry_samples = 0;
+    batch_init(&telemetry_batch, TELEMETRY_BATCH_SIZE);
+}
+
+/**
+ * @brief Change the snapshot period.
+ *
+ * The countdown restarts too, so a shorter period takes effect at once instead of after the old one.
+ */
+int telemetry_set_period(uint32_t period_ms)
+{
+    uint16_t ticks;
+
+    if (period_ms > TELEMETRY_MAX_PERIOD_MS)
+    {
+        return -1;
+    }
+
+    ticks = (uint16_t)((period_ms + SYSTICK_TIME / 2) / SYSTICK_TIME);
+    if (period_ms > 0 && ticks == 0)
+    {
+        ticks = 1;
+    }
+    telemetry_countdown = ticks;
+    telemetry_period = ticks;
+    return 0;
+}
+
+/**
+ * @brief Change the batch limits.
+ *
+ * A batch already holding more samples than the new size is sent on the next collection.
+ */
+int telemetry_set_batch(uint32_t size, uint32_t age_ms)
+{
+    if (size == 0 || size > BATCH_MAX_SAMPLES || age_ms > TELEMETRY_MAX_PERIOD_MS)
+    {
+        return -1;
+    }
+
+    batch_resize(&telemetry_batch, (uint8_t)size);
+    telemetry_batch_age_ms = (uint16_t)age_ms;
+    return 0;
+}
+
+/**
+ * @brief SysTick hook, raises `EVENT_TELEMETRY` on every call.
+ *
+ * Only the period is counted and the event raised here; the frames are built by PendSV, the same context
+ * that queues the text reports, so the UART channel has a single producer. Batches are checked for age on
+ * every SysTick period. The ADC raises the same event when a batch is waiting, so the count is what tells
+ * the consumer that a period passed.
+ */
+void telemetry_tick(void)
+{
+    telemetry_ticks++;
+    event_raise(EVENT_TELEMETRY);
+}
+
+/**
+ * @brief Encode a packet into the free frame buffer and hand it to the UART DMA channel.
+ *
+ * While a frame is waiting, the buffer not being sent is the waiting one, so nothing can be built.
+ * Otherwise the other buffer is free: the frame sent before it has completed.
+ *
+ * @return 0 if the frame was handed over, -1 if the channel already had one waiting.
+ */
+static int telemetry_send(uint8_t type, const uint8_t* payload, size_t length)
+{
+    uint8_t* frame = telemetry_frames[telemetry_next];
+
+    if (uart_frame_pending())
+    {
+        return -1;
+    }
+
+    length = uart_encode_packet(type, payload, length, frame);
+    uart_send_frame(frame, (uint32_t)length);
+    telemetry_next ^= 1;
+    return 0;
+}
+
+/**
+ * @brief Send the oldest samples of the batch as one frame.
+ *
+ * @return 0 if a frame was sent, -1 if the channel was busy.
+ */
+static int telemetry_flush(void)
+{
+    batch_counters_t counters;
+    uint8_t payload[PROTOCOL_MAX_PAYLOAD];
+    size_t length;
+
+    if (uart_frame_pending())
+    {
+        return -1;
+    }
+
+    counters.flags = (habilitar ? PROTOCOL_FLAG_ENABLED : 0) |
+                     (uint8_t)(adc_acquisition_mode << PROTOCOL_FLAG_MODE_SHIFT);
+    counters.adc_overruns = adc_ring.overruns;
+    counters.uart_dropped = uart_tx_ring.dropped;
+    length = batch_pack(&telemetry_batch, &counters, payload, sizeof(payload));
+    return telemetry_send(PROTOCOL_TYPE_BATCH, payload, length);
+}
+
+/**
+ * @brief Move the filtered samples from `adc_ring` into the batch, sending every batch that fills up.
+ *
+ * Samples are popped only up to the room left in the batch, so none is taken out of the ring that cannot
+ * be kept.
+ */
+void telemetry_collect(void)
+{
+    ring_sample_t samples[TELEMETRY_COLLECT_CHUNK];
+    size_t count;
+
+    for (;;)
+    {
+        size_t room;
+
+        if (telemetry_batch.count >= telemetry_batch.size && telemetry_flush() != 0)
+        {
+            return; /**< Full and the channel is busy: the ring holds the rest. */
+        }
+
+        room = (size_t)(telemetry_batch.size - telemetry_batch.count);
+        room = (room > TELEMETRY_COLLECT_CHUNK) ? TELEMETRY_COLLECT_CHUNK : room;
+        count = ring_pop_batch(&adc_ring, samples, room);
+        if (count == 0)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            batch_add(&telemetry_batch, samples[i].timestamp, samples[i].value,
+                      BATCH_STATE(samples[i].zone, samples[i].level));
+        }
+        telemetry_samples += (uint32_t)count;
+    }
+}
+
+/**
+ * @brief Take a snapshot of the system state.
+ *
+ * The fields are read one by one, without masking interrupts; each is consistent, the set may straddle
+ * an update, which is good enough for monitoring. The time stamp is the one of the packet header.
+ */
+void telemetry_capture(protocol_snapshot_t* snapshot)
+{
+    snapshot->value = (uint16_t)adc_read_value;
+    snapshot->distance = distance_mm;
+    snapshot->zone = proximity_zone;
+    snapshot->level = alarm_level;
+    snapshot->closing_speed = adc_tracker.closing_speed;
+    snapshot->ttc_ms = adc_tracker.ttc_ms;
+    snapshot->flags = (habilitar ? PROTOCOL_FLAG_ENABLED : 0) |
+                      (uint8_t)(adc_acquisition_mode << PROTOCOL_FLAG_MODE_SHIFT);
+    snapshot->adc_overruns = adc_ring.overruns;
+    snapshot->uart_dropped = uart_tx_ring.dropped;
+    snapshot->skipped = telemetry_skipped;
+}
+
+/**
+ * @brief Telemetry consumer of the periodic event.
+ *
+ * Batches go first, they hold the samples; a snapshot that finds the channel busy is only counted. When the switch
+ * disables the system the partial batch is sent at once, so the samples taken up to then do not wait for the age limit.
+ * The snapshot countdown only moves when SysTick counted a period since the previous call, never on the events raised
+ * by the ADC; periods that elapsed while PendSV was held off count as one, as merged events did.
+ */
+void telemetry_on_tick(uint32_t events)
+{
+    protocol_snapshot_t snapshot;
+    uint8_t payload[PROTOCOL_SNAPSHOT_SIZE];
+    uint8_t ticks = telemetry_ticks; /**< Single read, SysTick may count again meanwhile. */
+
+    telemetry_collect();
+    if (telemetry_batch.count > 0 &&
+        (((events & EVENT_ENABLE) && !habilitar) ||
+         batch_age(&telemetry_batch, timestamp_us()) >= (uint32_t)telemetry_batch_age_ms * 1000))
+    {
+        telemetry_flush();
+    }
+
+    if (ticks == telemetry_ticks_seen)
+    {
+        return; /**< Woken by the ADC, not by a SysTick period. */
+    }
+    telemetry_ticks_seen = ticks;
+
+    if (telemetry_period == 0 || --telemetry_countdown > 0)
+    {
+        return;
+    }
+    telemetry_countdown = telemetry_period;
+
+    telemetry_capture(&snapshot);
+    if (telemetry_send(PROTOCOL_TYPE_SNAPSHOT, payload, protocol_pack_snapshot(&snapshot, payload)) != 0 &&
+        telemetry_skipped < 0xFFFF)
+    {
+        telemetry_skipped++;
+    }
+}
@@ -0,0 +1,84 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleTime.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleTime.h"
+
+/**
+ * @file moduleTime.c
+ * @brief Implementation of the cycle counter and interval accumulators.
+ */
+
+/**
+ * @brief Start the DWT cycle counter.
+ *
+ * The DWT only runs when trace is enabled in the debug exception and monitor control register.
+ */
+void configure_cycle_counter(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; /**< Enable the DWT block */
+    DWT_CYCCNT = 0;                                 /**< Start counting from zero */
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;                 /**< Enable the cycle counter */
+}
+
+/**
+ * @brief Start the microsecond timestamp timer.
+ */
+void configure_timestamp_timer(void)
+{
+    TIM_TIMERCFG_Type timer_cfg_struct; /**< Structure to store timer settings. */
+
+    timer_cfg_struct.PrescaleOption = TIM_PRESCALE_USVAL; /**< Prescaler in microseconds. */
+    timer_cfg_struct.PrescaleValue = 1;                   /**< One count per microsecond. */
+
+    TIM_Init(TIMESTAMP_TIMER, TIM_TIMER_MODE, &timer_cfg_struct); /**< Power and initialize TIMER2. */
+    TIM_Cmd(TIMESTAMP_TIMER, ENABLE);                             /**< Free-running from now on. */
+}
+
+/**
+ * @brief Clear an interval accumulator.
+ *
+ * The minimum starts at the largest value so the first interval always replaces it.
+ */
+void cycle_stats_reset(cycle_stats_t* stats)
+{
+    stats->min = UINT32_MAX;
+    stats->max = 0;
+    stats->last = 0;
+    stats->count = 0;
+    stats->total = 0;
+}
+
+/**
+ * @brief Add one interval to an accumulator.
+ */
+void cycle_stats_add(cycle_stats_t* stats, uint32_t cycles)
+{
+    stats->min = (cycles < stats->min) ? cycles : stats->min;
+    stats->max = (cycles > stats->max) ? cycles : stats->max;
+    stats->last = cycles;
+    stats->count++;
+    stats->total += cycles;
+}
+
+/**
+ * @brief Average interval of an accumulator.
+ */
+uint32_t cycle_stats_average(const cycle_stats_t* stats)
+{
+    if (stats->count == 0)
+    {
+        return 0;
+    }
+    return (uint32_t)(stats->total / stats->count);
+}
@@ -0,0 +1,101 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleTracker.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleTracker.h"
+
+/**
+ * @file moduleTracker.c
+ * @brief Implementation of the alpha-beta distance tracker.
+ */
+
+/// Time to collision level of every zone, in milliseconds.
+static const uint16_t tracker_ttc_table[ZONE_COUNT] = TRACKER_TTC_TABLE;
+
+/**
+ * @brief Prepare a tracker for a distance stream.
+ *
+ * The only division by the sample rate happens here.
+ */
+void tracker_init(tracker_t* tracker, uint32_t rate_hz, int32_t alpha, int32_t beta)
+{
+    rate_hz = (rate_hz > 0) ? rate_hz : 1;
+
+    tracker->position = 0;
+    tracker->velocity = 0;
+    tracker->dt = (int32_t)((1UL << TRACKER_DT_Q) / rate_hz);
+    tracker->alpha = alpha;
+    tracker->velocity_gain = beta * (int32_t)rate_hz;
+    tracker->closing_speed = 0;
+    tracker->ttc_ms = TRACKER_TTC_NONE;
+    tracker->primed = 0;
+}
+
+/**
+ * @brief Feed one distance sample to the tracker.
+ *
+ * predicted = position + velocity * dt
+ * position  = predicted + alpha * (measured - predicted)
+ * velocity  = velocity + beta / dt * (measured - predicted)
+ */
+void tracker_update(tracker_t* tracker, uint16_t distance)
+{
+    int32_t measured = (int32_t)distance << TRACKER_Q;
+    int32_t predicted;
+    int32_t residual;
+    uint32_t closing;
+    uint32_t position_mm;
+
+    if (!tracker->primed)
+    {
+        tracker->position = measured; /**< Start at rest where the first sample is. */
+        tracker->primed = 1;
+    }
+
+    predicted = tracker->position + (int32_t)(((int64_t)tracker->velocity * tracker->dt) >> TRACKER_DT_Q);
+    residual = measured - predicted;
+
+    tracker->position = predicted + (int32_t)(((int64_t)tracker->alpha * residual) >> TRACKER_GAIN_Q);
+    tracker->velocity += (int32_t)(((int64_t)tracker->velocity_gain * residual) >> TRACKER_GAIN_Q);
+
+    closing = (tracker->velocity < 0) ? (uint32_t)(-tracker->velocity) >> TRACKER_Q : 0;
+    closing = (closing > UINT16_MAX) ? UINT16_MAX : closing;
+    position_mm = (tracker->position > 0) ? (uint32_t)tracker->position >> TRACKER_Q : 0;
+
+    tracker->closing_speed = (uint16_t)closing;
+    if (closing < TRACKER_MIN_CLOSING)
+    {
+        tracker->ttc_ms = TRACKER_TTC_NONE;
+    }
+    else
+    {
+        uint32_t ttc = position_mm * 1000 / closing; /**< Hardware divide on the Cortex-M3. */
+        tracker->ttc_ms = (uint16_t)((ttc < TRACKER_TTC_NONE) ? ttc : TRACKER_TTC_NONE);
+    }
+}
+
+/**
+ * @brief Alarm level demanded by the time to collision.
+ *
+ * Bounded by the number of zones.
+ */
+uint8_t tracker_urgency(const tracker_t* tracker)
+{
+    uint8_t level = ZONE_CLEAR;
+
+    while (level + 1 < ZONE_COUNT && tracker->ttc_ms < tracker_ttc_table[level + 1])
+    {
+        level++;
+    }
+    return level;
+}
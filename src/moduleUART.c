@@ -13,123 +13,660 @@
  * All rights reserved.
  ****************************************************************************/
 #include "moduleUART.h"
+#include "moduleTelemetry.h"
 
-volatile uint32_t table_uart[4] = {send_adc_value, // Conversion to proper pointer
-                                   send_status_leds,
-                                   notify_interruption_status,
-                                   send_system_status};
+byte_ring_t uart_tx_ring;
+uint8_t uart_dma_channel = DMA_NONE;
+static uint8_t uart_tx_storage[UART_TX_RING_SIZE];
+byte_ring_t uart_rx_ring;
+command_parser_t uart_command_parser;
+static uint8_t uart_rx_storage[UART_RX_RING_SIZE];
+
+static volatile uint8_t uart_tx_busy = 0;            /**< A transfer is running on the UART channel. */
+static volatile uint32_t uart_tx_chunk = 0;          /**< Ring bytes in the running transfer. */
+static const uint8_t* volatile uart_tx_frame = NULL; /**< Frame waiting for the channel. */
+static volatile uint32_t uart_tx_frame_length = 0;   /**< Length of the waiting frame. */
+static uint8_t uart_sequence = 0;                    /**< Sequence number of the next packet. */
+
+volatile uint32_t uart_baud = COMMUNICATION_SPEED;
+volatile uint8_t uart_autobaud_state = UART_AUTOBAUD_IDLE;
+static volatile uint32_t uart_baud_pending = 0;     /**< Rate to switch to once the line is idle, 0 if none. */
+static volatile uint32_t uart_autobaud_rate = 0;    /**< Standard rate matching the auto-baud measurement. */
+static volatile uint16_t uart_autobaud_countdown;   /**< SysTick periods left for the host to send 'A'. */
+
+static void uart_tx_next(void);
 
 /**
  * @brief Configure the UART.
  *
- * Initialize the UART with default settings.
+ * Initialize the UART with default settings, with the FIFO requesting DMA transfers, and reserve the DMA
+ * channel that feeds it. @ref configure_dma must have been called before.
  */
 void conf_UART(void)
 {
     UART_CFG_Type uart_cfg;
+    UART_ConfigStructInit(&uart_cfg);         /* Defaults first, it would overwrite the fields below. */
     uart_cfg.Baud_rate = COMMUNICATION_SPEED; /*  This is the communication speed value in bits per second.
                                                   For example, if you want a speed of 9600 bps */
     uart_cfg.Parity = UART_PARITY_NONE;
     uart_cfg.Databits = UART_DATABIT_8;
     uart_cfg.Stopbits = UART_STOPBIT_1;
-    UART_ConfigStructInit(&uart_cfg);
 
-    UART_IntConfig(LPC_UART0, UART_INTCFG_THRE, ENABLE); /* UART_INTCFG_THRE Enables interrupting when the
- Transmit Holding Register (THR) is empty, indicating that the UART is ready to send new data. */
+    CLKPWR_SetPCLKDiv(CLKPWR_PCLKSEL_UART0, CLKPWR_PCLKSEL_CCLK_DIV_1); /* 100 MHz, needed above 460800 bps */
     UART_Init(LPC_UART0, &uart_cfg);
+    uart_baud = COMMUNICATION_SPEED;
+    uart_baud_pending = 0;
+    uart_autobaud_state = UART_AUTOBAUD_IDLE;
+    uart_apply_baud(COMMUNICATION_SPEED); /* The driver ignores the DL >= 3 rule of the fractional divider. */
 
     UART_FIFO_CFG_Type UARTFIFOConfigStruct;
-    UART_FIFOConfigStructInit(&UARTFIFOConfigStruct); // FIFO configuration
+    UART_FIFOConfigStructInit(&UARTFIFOConfigStruct);    // FIFO configuration
+    UARTFIFOConfigStruct.FIFO_DMAMode = ENABLE;          // The transmit FIFO requests GPDMA transfers
+    UARTFIFOConfigStruct.FIFO_Level = UART_FIFO_TRGLEV2; // One receive interrupt per 8 bytes, or on time-out
     UART_FIFOConfig(LPC_UART0, &UARTFIFOConfigStruct);
 
+    byte_ring_init(&uart_tx_ring, uart_tx_storage, UART_TX_RING_SIZE);
+    uart_tx_busy = 0;
+    uart_tx_chunk = 0;
+    uart_tx_frame = NULL;
+    byte_ring_init(&uart_rx_ring, uart_rx_storage, UART_RX_RING_SIZE);
+    command_parser_init(&uart_command_parser);
+
+    if (uart_dma_channel == DMA_NONE)
+    {
+        uart_dma_channel = dma_channel_reserve(DMA_PRIORITY_UART, uart_on_dma); /**< Least urgent DMA user */
+    }
+
     UART_TxCmd(LPC_UART0, ENABLE); // Enable streaming
+
+    UART_IntConfig(LPC_UART0, UART_INTCFG_RBR, ENABLE);  // Received data and character time-out
+    UART_IntConfig(LPC_UART0, UART_INTCFG_RLS, ENABLE);  // Line status: a break asks for auto-baud
+    UART_IntConfig(LPC_UART0, UART_INTCFG_ABEO, ENABLE); // End of auto-baud
+    UART_IntConfig(LPC_UART0, UART_INTCFG_ABTO, ENABLE); // Auto-baud time-out
+    NVIC_EnableIRQ(UART0_IRQn);
+}
+
+/**
+ * @brief Program the divisor latches and the fractional divider for a rate.
+ */
+int uart_apply_baud(uint32_t baud)
+{
+    baud_divider_t divider;
+
+    if (baud_divider(CLKPWR_GetPCLK(CLKPWR_PCLKSEL_UART0), baud, &divider) != 0)
+    {
+        return -1;
+    }
+
+    LPC_UART0->LCR |= UART_LCR_DLAB_EN;
+    LPC_UART0->DLM = UART_LOAD_DLM(divider.divisor);
+    LPC_UART0->DLL = UART_LOAD_DLL(divider.divisor);
+    LPC_UART0->LCR &= (~UART_LCR_DLAB_EN) & UART_LCR_BITMASK;
+    LPC_UART0->FDR = (UART_FDR_MULVAL(divider.mulval) | UART_FDR_DIVADDVAL(divider.divaddval)) & UART_FDR_BITMASK;
+    return 0;
+}
+
+/**
+ * @brief Ask for a new line rate.
+ *
+ * The rate is checked now and announced at the current rate; it is applied by @ref uart_on_baud.
+ */
+int uart_set_baud(uint32_t baud)
+{
+    baud_divider_t divider;
+    char buffer[40];
+    char* p = buffer;
+
+    if (baud_divider(CLKPWR_GetPCLK(CLKPWR_PCLKSEL_UART0), baud, &divider) != 0)
+    {
+        return -1;
+    }
+
+    p += format_text(p, "Baud: ");
+    p += format_unsigned(p, baud);
+    p += format_text(p, " (");
+    p += format_signed(p, divider.error_ppm);
+    p += format_text(p, " ppm)\n");
+    uart_send_log(buffer, (size_t)(p - buffer));
+
+    uart_baud_pending = baud;
+    return 0;
+}
+
+/**
+ * @brief Ask for auto-baud detection.
+ */
+void uart_autobaud(void)
+{
+    if (uart_autobaud_state == UART_AUTOBAUD_IDLE)
+    {
+        uart_autobaud_state = UART_AUTOBAUD_REQUESTED;
+    }
+}
+
+/**
+ * @brief SysTick hook of the line rate management.
+ *
+ * Raises `EVENT_BAUD` while there is work for @ref uart_on_baud, and ends an auto-baud detection that the
+ * host did not complete in time.
+ */
+void uart_tick(void)
+{
+    if (uart_autobaud_state == UART_AUTOBAUD_ARMED && --uart_autobaud_countdown == 0)
+    {
+        uart_autobaud_state = UART_AUTOBAUD_EXPIRED;
+    }
+
+    if (uart_baud_pending != 0 || (uart_autobaud_state != UART_AUTOBAUD_IDLE &&
+                                   uart_autobaud_state != UART_AUTOBAUD_ARMED))
+    {
+        event_raise(EVENT_BAUD);
+    }
+}
+
+/**
+ * @brief Discard the received bytes, in the FIFO and in the ring, and the line they started.
+ */
+static void uart_rx_flush(void)
+{
+    NVIC_DisableIRQ(UART0_IRQn);
+    while (LPC_UART0->LSR & UART_LSR_RDR)
+    {
+        (void)LPC_UART0->RBR;
+    }
+    NVIC_EnableIRQ(UART0_IRQn);
+    byte_ring_skip(&uart_rx_ring, byte_ring_count(&uart_rx_ring));
+    command_parser_reset(&uart_command_parser);
+}
+
+/**
+ * @brief Line rate consumer of the periodic event.
+ *
+ * Runs in PendSV, like every producer of the UART channel, so nothing can start a transfer while the rate
+ * changes. A change waits for a moment where the channel is idle and the shift register empty, which is
+ * most of the time at the telemetry rate; the check is retried on every SysTick period, never spun on.
+ * Transmission is held while auto-baud is armed, the host is listening at a rate not known yet.
+ */
+void uart_on_baud(uint32_t events)
+{
+    uint8_t idle;
+
+    (void)events;
+
+    dma_irq_lock();
+    idle = !uart_tx_busy && (LPC_UART0->LSR & UART_LSR_TEMT);
+
+    switch (uart_autobaud_state)
+    {
+        case UART_AUTOBAUD_DONE:
+            uart_rx_flush();                     /**< Break and 'A', received at the wrong rate. */
+            uart_apply_baud(uart_autobaud_rate); /**< Replace the measured divisor by the exact one. */
+            uart_baud = uart_autobaud_rate;
+            uart_autobaud_state = UART_AUTOBAUD_IDLE;
+            break;
+        case UART_AUTOBAUD_EXPIRED:
+            UART_ABCmd(LPC_UART0, NULL, DISABLE);
+            uart_apply_baud(uart_baud); /**< Back to the rate in use before. */
+            uart_autobaud_state = UART_AUTOBAUD_IDLE;
+            break;
+        case UART_AUTOBAUD_REQUESTED:
+            if (idle)
+            {
+                UART_AB_CFG_Type autobaud;
+                autobaud.ABMode = UART_AUTOBAUD_MODE0;
+                autobaud.AutoRestart = ENABLE; /**< Measure again after a bad start bit. */
+                uart_autobaud_countdown = UART_AUTOBAUD_TIMEOUT_TICKS;
+                uart_autobaud_state = UART_AUTOBAUD_ARMED;
+                UART_ABCmd(LPC_UART0, &autobaud, ENABLE);
+            }
+            break;
+        default: break;
+    }
+
+    if (uart_baud_pending != 0 && uart_autobaud_state == UART_AUTOBAUD_IDLE && idle)
+    {
+        uart_apply_baud(uart_baud_pending);
+        uart_baud = uart_baud_pending;
+        uart_baud_pending = 0;
+    }
+
+    if (!uart_tx_busy)
+    {
+        uart_tx_next();
+    }
+    dma_irq_unlock();
+}
+
+/**
+ * @brief Run one command and answer it.
+ */
+static void uart_execute(const command_t* command)
+{
+    const uint32_t* argv = command->argv;
+    int result = -1;
+    uint32_t value = 0; /**< Value obtained, when it may differ from the one asked for. */
+    char buffer[COMMAND_REPLY_MAX];
+
+    switch (command->id)
+    {
+        case COMMAND_ZONE:
+            if (argv[0] < ZONE_COUNT && argv[1] <= UINT16_MAX && argv[2] <= UINT16_MAX)
+            {
+                result = zone_set_band((uint8_t)argv[0], (uint16_t)argv[1], (uint16_t)argv[2]);
+            }
+            break;
+        case COMMAND_RATE:
+            if (argv[0] > 0)
+            {
+                value = adc_set_output_rate(argv[0]);
+                result = 0;
+            }
+            break;
+        case COMMAND_TELEMETRY: result = telemetry_set_period(argv[0]); break;
+        case COMMAND_MODE:
+            if (argv[0] < ADC_MODE_COUNT)
+            {
+                adc_start_acquisition((uint8_t)argv[0]);
+                result = 0;
+            }
+            break;
+        case COMMAND_BAUD:
+            if (command->argc == 0)
+            {
+                uart_autobaud();
+                result = 0;
+            }
+            else
+            {
+                result = uart_set_baud(argv[0]);
+            }
+            break;
+        case COMMAND_STATUS:
+            send_status_packet();
+            send_jitter_report();
+            send_isr_report();
+            send_mix_report();
+            result = 0;
+            break;
+        case COMMAND_BATCH:
+            result = telemetry_set_batch(argv[0], (command->argc > 1) ? argv[1] : telemetry_batch_age_ms);
+            break;
+        default: break;
+    }
+
+    uart_send_log(buffer, command_reply(command, result, value, buffer));
 }
 
 /**
- * @brief Configures the DAC and UART for data transfer using DMA.
+ * @brief Command consumer of the received bytes.
  *
- * This function initializes the DMA and sets up a linked list item (LLI)
- * for continuous data transfer from a memory table to the UART transmit register.
- * The DMA channel is configured for memory-to-peripheral transfer.
+ * The parser takes each contiguous run of the ring as is and stops after every completed line, so the
+ * command runs before the following bytes are looked at.
  */
-void configure_dac_uart(void)
+void uart_on_command(uint32_t events)
 {
-    GPDMA_LLI_Type DMA_LLI_Struct; /**< DMA linked list element for continuous transfer */
+    const uint8_t* data;
+    size_t count;
+    command_t command;
 
-    // Configure the DMA linked list for continuous transfer
-    DMA_LLI_Struct.SrcAddr = (uint32_t)table_uart;          /**< Source address: wave table */
-    DMA_LLI_Struct.DstAddr = (uint32_t) & (LPC_UART0->THR); /**< Destination address: UART transmit register */
-    DMA_LLI_Struct.NextLLI = (uint32_t)&DMA_LLI_Struct;     /**< Link to same item for continuous transfer */
-    DMA_LLI_Struct.Control = DMA_SIZE                       /**< Transfer size */
-                             | (2 << 18)                    /**< Source width: 32 bits */
-                             | (2 << 21)                    /**< Destination width: 32 bits */
-                             | (1 << 26);                   /**< Increment source address */
+    (void)events;
 
-    GPDMA_Init(); /**< Initialize the GPDMA controller */
+    while ((count = byte_ring_peek(&uart_rx_ring, &data)) > 0)
+    {
+        byte_ring_skip(&uart_rx_ring, command_feed(&uart_command_parser, data, count, &command));
+        if (command.id != COMMAND_NONE)
+        {
+            uart_execute(&command);
+        }
+    }
+}
+
+/**
+ * @brief UART0 interrupt handler.
+ *
+ * Received bytes, on the FIFO trigger level or the character time-out, are moved to @ref uart_rx_ring
+ * and left to PendSV. End of auto-baud: the hardware has loaded the divisor it measured on the host 'A';
+ * the closest standard rate is kept for @ref uart_on_baud. A break on the line asks for a new auto-baud
+ * detection.
+ */
+void UART0_IRQHandler(void)
+{
+    uint32_t interrupt_id = LPC_UART0->IIR;
+    uint8_t line_status = LPC_UART0->LSR; /**< Also clears the receive error flags. */
+
+    if (interrupt_id & UART_IIR_ABEO_INT)
+    {
+        uint16_t divisor;
+
+        LPC_UART0->LCR |= UART_LCR_DLAB_EN;
+        divisor = (uint16_t)((LPC_UART0->DLM << 8) | LPC_UART0->DLL);
+        LPC_UART0->LCR &= (~UART_LCR_DLAB_EN) & UART_LCR_BITMASK;
+
+        UART_ABClearIntPending(LPC_UART0, UART_AUTOBAUD_INTSTAT_ABEO);
+        UART_ABCmd(LPC_UART0, NULL, DISABLE);
+        if (uart_autobaud_state == UART_AUTOBAUD_ARMED && divisor > 0)
+        {
+            uart_autobaud_rate = baud_snap(CLKPWR_GetPCLK(CLKPWR_PCLKSEL_UART0) / (16 * (uint32_t)divisor));
+            uart_autobaud_state = UART_AUTOBAUD_DONE;
+            event_raise(EVENT_BAUD);
+        }
+    }
+
+    if (interrupt_id & UART_IIR_ABTO_INT)
+    {
+        UART_ABClearIntPending(LPC_UART0, UART_AUTOBAUD_INTSTAT_ABTO); /**< Restarts by itself. */
+    }
 
-    // DMA channel configuration structure
+    if (line_status & UART_LSR_BI)
+    {
+        uart_autobaud();
+        event_raise(EVENT_BAUD);
+    }
+
+    if (line_status & UART_LSR_RDR)
+    {
+        do
+        {
+            uint8_t byte = (uint8_t)LPC_UART0->RBR;
+            byte_ring_write(&uart_rx_ring, &byte, 1); /**< Counted in `dropped` when full. */
+        } while (LPC_UART0->LSR & UART_LSR_RDR);
+        event_raise(EVENT_COMMAND);
+    }
+}
+
+/**
+ * @brief Start a memory-to-UART transfer on the UART channel.
+ *
+ * The channel disables itself on terminal count, so it can be set up again from the callback.
+ */
+static void uart_tx_start(const uint8_t* data, uint32_t length)
+{
     GPDMA_Channel_CFG_Type dma_config;
-    dma_config.ChannelNum = 2;                        /**< Use DMA channel 2 */
-    dma_config.TransferSize = UART_BUFFER_SIZE;       /**< Size of the transfer */
+    dma_config.ChannelNum = uart_dma_channel;         /**< Reserved UART channel */
+    dma_config.TransferSize = length;                 /**< Bytes, the UART connection is byte wide */
     dma_config.TransferWidth = 0;                     /**< Not applicable for UART transfer */
-    dma_config.SrcMemAddr = (uint32_t)table_uart;     /**< Source memory address: wave table */
+    dma_config.SrcMemAddr = (uint32_t)data;           /**< Source memory address: frame or ring bytes */
     dma_config.DstMemAddr = 0;                        /**< Destination is a peripheral (UART) */
     dma_config.TransferType = GPDMA_TRANSFERTYPE_M2P; /**< Memory-to-peripheral transfer */
     dma_config.SrcConn = 0;                           /**< Source is memory */
     dma_config.DstConn = GPDMA_CONN_UART0_Tx;         /**< Destination is UART0 transmit */
     dma_config.DMALLI = 0;                            /**< No linked list */
 
-    GPDMA_Setup(&dma_config);    /**< Configure the DMA channel */
-    GPDMA_ChannelCmd(2, ENABLE); /**< Enable DMA channel 2 */
+    GPDMA_Setup(&dma_config);
+    GPDMA_ChannelCmd(uart_dma_channel, ENABLE);
+    uart_tx_busy = 1;
 }
 
 /**
- * @brief Sends the ADC value via UART.
+ * @brief Start the next transfer, if there is something to send.
  *
- * @return Buffer with the information to be transmitted.
+ * A waiting frame goes first, it is periodic and time stamped; otherwise the oldest contiguous run of the
+ * ring is sent. Nothing is sent while auto-baud is armed. Runs from the DMA callback or inside
+ * @ref dma_irq_lock.
  */
-uint32_t send_adc_value(void)
+static void uart_tx_next(void)
 {
-    char buffer[100];
-    sprintf(buffer, "ADC: %lu\n", adc_read_value);
-    return UART_Send(LPC_UART0, (uint8_t*)buffer, strlen((const char*)buffer), BLOCKING);
+    const uint8_t* data;
+    size_t count;
+
+    if (uart_autobaud_state == UART_AUTOBAUD_ARMED)
+    {
+        uart_tx_busy = 0; /**< Held until the host rate is known. */
+        return;
+    }
+
+    if (uart_tx_frame != NULL)
+    {
+        const uint8_t* frame = uart_tx_frame;
+        uart_tx_frame = NULL;
+        uart_tx_start(frame, uart_tx_frame_length);
+        return;
+    }
+
+    count = byte_ring_peek(&uart_tx_ring, &data);
+    if (count > 0)
+    {
+        uart_tx_chunk = (uint32_t)count;
+        uart_tx_start(data, (uint32_t)count);
+        return;
+    }
+
+    uart_tx_busy = 0;
 }
 
 /**
- * @brief Send the status of the LEDs via UART.
+ * @brief Queue a message for transmission on UART0 without waiting.
  *
- * Informs if the system is in reverse or normal mode.
- * @return Buffer with the information to be transmitted.
+ * If the channel is idle the transfer is started here; otherwise the DMA callback picks the message up.
+ * The DMA interrupt is masked only around that check, never while waiting for the line.
  */
-uint32_t send_status_leds(void)
+uint32_t uart_write(const uint8_t* data, uint32_t length)
 {
-    char buffer[100];
-    sprintf(buffer, "Reverse mode: %s\n", reverse_flag ? "Enable" : "Disabled");
-    return UART_Send(LPC_UART0, (uint8_t*)buffer, strlen((const char*)buffer), BLOCKING);
+    uint32_t queued = (uint32_t)byte_ring_write(&uart_tx_ring, data, length);
+
+    dma_irq_lock();
+    if (!uart_tx_busy)
+    {
+        uart_tx_next();
+    }
+    dma_irq_unlock();
+    return queued;
+}
+
+/**
+ * @brief Hand a frame to the UART channel without copying it.
+ */
+int uart_send_frame(const uint8_t* frame, uint32_t length)
+{
+    int result = -1;
+
+    dma_irq_lock();
+    if (uart_tx_frame == NULL)
+    {
+        uart_tx_frame_length = length;
+        uart_tx_frame = frame;
+        if (!uart_tx_busy)
+        {
+            uart_tx_next();
+        }
+        result = 0;
+    }
+    dma_irq_unlock();
+    return result;
+}
+
+/**
+ * @brief Whether a frame is still waiting for the UART channel.
+ */
+uint8_t uart_frame_pending(void)
+{
+    return uart_tx_frame != NULL;
+}
+
+/**
+ * @brief Encode a packet, numbered and time stamped now.
+ */
+size_t uart_encode_packet(uint8_t type, const uint8_t* payload, size_t length, uint8_t* frame)
+{
+    protocol_header_t header;
+
+    header.type = type;
+    header.sequence = uart_sequence++;
+    header.timestamp = TIMESTAMP_TIMER->TC;
+    return protocol_encode(&header, payload, length, frame);
 }
 
 /**
- * @brief Notify switch status via UART.
+ * @brief Queue a packet for transmission on UART0 without waiting.
  *
- * Indicates whether the switch is enabled or disabled.
- * @return Buffer with the information to be transmitted.
+ * The frame is built on the stack and copied into the transmit ring as a whole.
+ */
+uint32_t uart_send_packet(uint8_t type, const uint8_t* payload, size_t length)
+{
+    uint8_t frame[PROTOCOL_FRAME_MAX];
+    size_t size = uart_encode_packet(type, payload, length, frame);
+
+    return (size > 0) ? uart_write(frame, (uint32_t)size) : 0;
+}
+
+/**
+ * @brief Queue a text message as a log packet.
  */
-uint32_t notify_interruption_status(void)
+uint32_t uart_send_text(const char* text)
+{
+    return uart_send_log(text, strlen(text));
+}
+
+/**
+ * @brief Queue text of a known length as a log packet.
+ *
+ * Text longer than a payload is cut.
+ */
+uint32_t uart_send_log(const char* text, size_t length)
+{
+    if (length > PROTOCOL_MAX_PAYLOAD)
+    {
+        length = PROTOCOL_MAX_PAYLOAD;
+    }
+    return uart_send_packet(PROTOCOL_TYPE_LOG, (const uint8_t*)text, length);
+}
+
+/**
+ * @brief DMA callback of the UART channel.
+ *
+ * Releases the ring bytes of the finished transfer, lost as well on a bus error, and chains the next one.
+ */
+void uart_on_dma(uint8_t channel, uint32_t status)
+{
+    (void)channel;
+    (void)status;
+
+    if (uart_tx_chunk > 0)
+    {
+        byte_ring_skip(&uart_tx_ring, uart_tx_chunk);
+        uart_tx_chunk = 0;
+    }
+    uart_tx_next();
+}
+
+/**
+ * @brief Sends a binary status packet via UART.
+ *
+ * Moves the pending samples into the telemetry batch first, which sends them as `PROTOCOL_TYPE_BATCH`
+ * frames once full or old enough, then packs the newest sample, the zone, the alarm level, the tracker
+ * output and the sample counters into a `PROTOCOL_TYPE_STATUS` packet: about 30 bytes on the wire
+ * instead of the two text lines.
+ * @return Number of bytes queued, 0 if the transmit ring was full.
+ */
+uint32_t send_status_packet(void)
+{
+    static uint32_t reported = 0; /**< @ref telemetry_samples at the previous report. */
+    protocol_status_t status;
+    uint8_t payload[PROTOCOL_STATUS_SIZE];
+
+    telemetry_collect();
+
+    status.value = (uint16_t)adc_read_value;
+    status.distance = distance_mm;
+    status.zone = proximity_zone;
+    status.level = alarm_level;
+    status.closing_speed = adc_tracker.closing_speed;
+    status.ttc_ms = adc_tracker.ttc_ms;
+    status.samples = telemetry_samples - reported;
+    status.overruns = adc_ring.overruns;
+    reported = telemetry_samples;
+    protocol_pack_status(&status, payload);
+    return uart_send_packet(PROTOCOL_TYPE_STATUS, payload, PROTOCOL_STATUS_SIZE);
+}
+
+/**
+ * @brief Write "average/maximum" of a series of cycle counts.
+ */
+static size_t format_stats(char* out, const cycle_stats_t* stats)
+{
+    size_t count = format_unsigned(out, cycle_stats_average(stats));
+
+    out[count++] = '/';
+    return count + format_unsigned(out + count, stats->max);
+}
+
+/**
+ * @brief Sends the sample-period jitter of the per-sample acquisition modes via UART.
+ *
+ * Jitter is the difference between the longest and the shortest period, all values in CPU cycles.
+ * A mode that has not run yet reports zeros.
+ * @return Number of bytes queued, 0 if the transmit ring was full.
+ */
+uint32_t send_jitter_report(void)
 {
     char buffer[100];
-    sprintf(buffer, "Switch: %s\n", habilitar ? "Enable" : "Disabled");
-    return UART_Send(LPC_UART0, (uint8_t*)buffer, strlen(buffer), BLOCKING);
+    char* p = buffer;
+    const cycle_stats_t* timer = &adc_period_stats[ADC_MODE_TIMER_IRQ];
+    const cycle_stats_t* match = &adc_period_stats[ADC_MODE_MATCH_EDGE];
+    uint32_t timer_jitter = (timer->count > 0) ? timer->max - timer->min : 0;
+    uint32_t match_jitter = (match->count > 0) ? match->max - match->min : 0;
+
+    p += format_text(p, "Jitter: timer-irq ");
+    p += format_unsigned(p, timer_jitter);
+    p += format_text(p, " (n=");
+    p += format_unsigned(p, timer->count);
+    p += format_text(p, ") | match-edge ");
+    p += format_unsigned(p, match_jitter);
+    p += format_text(p, " (n=");
+    p += format_unsigned(p, match->count);
+    p += format_text(p, ")\n");
+    return uart_send_log(buffer, (size_t)(p - buffer));
+}
+
+/**
+ * @brief Sends the cost of the ADC interrupt via UART.
+ *
+ * Average and worst case of the handler duration, of the time from conversion start to handler entry and
+ * of the per-sample PendSV pipeline, all in CPU cycles. The handler name tells which one was built.
+ * @return Number of bytes queued, 0 if the transmit ring was full.
+ */
+uint32_t send_isr_report(void)
+{
+    char buffer[128];
+    char* p = buffer;
+
+    p += format_text(p, ADC_ISR_LEGACY ? "ADC ISR legacy: " : "ADC ISR minimal: ");
+    p += format_stats(p, &adc_isr_stats);
+    p += format_text(p, " | latency ");
+    p += format_stats(p, &adc_latency_stats);
+    p += format_text(p, " | pipeline ");
+    p += format_stats(p, &adc_pipeline_stats);
+    p += format_text(p, " (avg/max cycles)\n");
+    return uart_send_log(buffer, (size_t)(p - buffer));
 }
 
 /**
- * @brief Sends the general status of the system via UART.
+ * @brief Sends the cost of the tone mixer via UART.
  *
- * Provides information about the current operating mode.
- * @return Buffer with the information to be transmitted.
+ * Average and worst case, in CPU cycles, of rendering one block of `DAC_MIX_BLOCK` samples, together with
+ * the mixer counters. Zeros mean that no scan has been mixed yet.
+ * @return Number of bytes queued, 0 if the transmit ring was full.
  */
-uint32_t send_system_status(void)
+uint32_t send_mix_report(void)
 {
     char buffer[100];
-    sprintf(buffer, "System: %s\n", reverse_flag ? "Reverse" : "Moving forward");
-    return UART_Send(LPC_UART0, (uint8_t*)buffer, strlen(buffer), BLOCKING);
+    char* p = buffer;
+
+    p += format_text(p, "Mixer: ");
+    p += format_stats(p, &dac_mix_stats);
+    p += format_text(p, " cycles per block (avg/max) | ");
+    p += format_unsigned(p, dac_mixer.blocks);
+    p += format_text(p, " blocks, ");
+    p += format_unsigned(p, dac_mixer.clipped);
+    p += format_text(p, " clipped\n");
+    return uart_send_log(buffer, (size_t)(p - buffer));
+}
+
+/**
+ * @brief Zone change consumer of the UART.
+ */
+void uart_on_zone_change(uint32_t events)
+{
+    (void)events;
+    send_status_packet();
 }
@@ -0,0 +1,78 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    moduleZone.c
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "moduleZone.h"
+
+/**
+ * @file moduleZone.c
+ * @brief Implementation of the proximity zone classifier.
+ */
+
+zone_band_t zone_table[ZONE_COUNT] = ZONE_TABLE;
+
+/// Names of the zones, indexed by zone.
+static const char* const zone_names[ZONE_COUNT] = {"clear", "caution", "warning", "danger"};
+
+/**
+ * @brief Compute the zone of a reading, given the zone of the previous one.
+ *
+ * Both loops are bounded by the number of zones.
+ */
+uint8_t zone_classify(uint8_t current, uint16_t value)
+{
+    uint8_t zone = (current < ZONE_COUNT) ? current : ZONE_CLEAR;
+
+    while (zone + 1 < ZONE_COUNT && value < zone_table[zone + 1].enter)
+    {
+        zone++; /**< Nearer. */
+    }
+    while (zone > ZONE_CLEAR && value > zone_table[zone].exit)
+    {
+        zone--; /**< Farther. */
+    }
+    return zone;
+}
+
+/**
+ * @brief Change the band of one zone.
+ *
+ * The farther zone is `zone - 1`; `ZONE_CAUTION` has none, the row of `ZONE_CLEAR` is not a band.
+ */
+int zone_set_band(uint8_t zone, uint16_t enter, uint16_t exit)
+{
+    if (zone == ZONE_CLEAR || zone >= ZONE_COUNT || enter >= exit)
+    {
+        return -1;
+    }
+    if (zone > ZONE_CAUTION && exit >= zone_table[zone - 1].enter)
+    {
+        return -1;
+    }
+    if (zone + 1 < ZONE_COUNT && enter <= zone_table[zone + 1].exit)
+    {
+        return -1;
+    }
+
+    zone_table[zone].enter = enter;
+    zone_table[zone].exit = exit;
+    return 0;
+}
+
+/**
+ * @brief Short human readable name of a zone.
+ */
+const char* zone_name(uint8_t zone)
+{
+    return (zone < ZONE_COUNT) ? zone_names[zone] : "?";
+}
@@ -0,0 +1,89 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    Bench.hpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef TELEMETRY_BENCH_HPP
+#define TELEMETRY_BENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_CYCLES 1 ///< The time stamp counter gives a cycle figure next to the time.
+#else
+#define BENCH_HAS_CYCLES 0
+#endif
+
+/**
+ * @file Bench.hpp
+ * @brief Timing helpers shared by the host benchmarks.
+ *
+ * The firmware modules are linked from the host library, compiled separately and without link time
+ * optimization, so the calls being timed cannot be folded away. Host figures compare code paths with each
+ * other; they are not Cortex-M3 cycle counts.
+ */
+
+namespace bench
+{
+
+/**
+ * @brief Cost of one item of work.
+ */
+struct Cost
+{
+    double ns;     ///< Nanoseconds per item.
+    double cycles; ///< Time stamp counter ticks per item, 0 where there is no counter.
+};
+
+/**
+ * @brief Read the time stamp counter, 0 where there is none.
+ */
+inline uint64_t cycles()
+{
+#if BENCH_HAS_CYCLES
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Time a piece of work.
+ *
+ * @param items   Items processed by one call of `body`.
+ * @param repeats Calls of `body`; the first one is run once more before timing, to warm the caches.
+ * @param body    Work to time.
+ * @return Cost per item, averaged over the repeats.
+ */
+template <typename Body> Cost measure(size_t items, int repeats, Body&& body)
+{
+    body();
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t ticks = cycles();
+    for (int i = 0; i < repeats; i++)
+    {
+        body();
+    }
+    ticks = cycles() - ticks;
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double total = static_cast<double>(items) * repeats;
+    return Cost{elapsed * 1e9 / total, static_cast<double>(ticks) / total};
+}
+
+} // namespace bench
+
+#endif // TELEMETRY_BENCH_HPP
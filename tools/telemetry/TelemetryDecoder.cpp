@@ -0,0 +1,163 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    TelemetryDecoder.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "TelemetryDecoder.hpp"
+
+#include <cstdio>
+
+/**
+ * @file TelemetryDecoder.cpp
+ * @brief Implementation of the host decoder of the UART link packets.
+ */
+
+namespace telemetry
+{
+
+namespace
+{
+
+/// Zone names, in ZONE_* order.
+const char* const zone_names[] = {"clear", "caution", "warning", "danger"};
+
+const char* zoneName(uint8_t zone)
+{
+    return (zone < sizeof(zone_names) / sizeof(zone_names[0])) ? zone_names[zone] : "?";
+}
+
+std::string hex(const std::vector<uint8_t>& bytes)
+{
+    std::string text;
+    char digits[4];
+
+    for (uint8_t byte : bytes)
+    {
+        std::snprintf(digits, sizeof(digits), "%02X ", byte);
+        text += digits;
+    }
+    return text;
+}
+
+} // namespace
+
+Decoder::Decoder(Handler handler) : handler_(std::move(handler))
+{
+    protocol_decoder_init(&state_);
+}
+
+/**
+ * The sequence number is shared by every packet type, so any gap is a lost packet, whatever its type.
+ */
+void Decoder::feed(const uint8_t* data, size_t length)
+{
+    Packet packet;
+    const uint8_t* payload;
+    size_t size;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (!protocol_decoder_feed(&state_, data[i], &packet.header, &payload, &size))
+        {
+            continue;
+        }
+
+        if (synced_)
+        {
+            lost_ += static_cast<uint8_t>(packet.header.sequence - nextSequence_);
+        }
+        synced_ = true;
+        nextSequence_ = static_cast<uint8_t>(packet.header.sequence + 1);
+
+        packet.payload.assign(payload, payload + size);
+        handler_(packet);
+    }
+}
+
+std::string describe(const Packet& packet)
+{
+    char line[200];
+    int prefix = std::snprintf(line, sizeof(line), "%10u us #%3u ", static_cast<unsigned>(packet.header.timestamp),
+                               static_cast<unsigned>(packet.header.sequence));
+    char* body = line + prefix;
+    size_t room = sizeof(line) - static_cast<size_t>(prefix);
+    protocol_snapshot_t snapshot;
+    protocol_status_t status;
+    batch_frame_t frame;
+
+    switch (packet.header.type)
+    {
+        case PROTOCOL_TYPE_SNAPSHOT:
+            if (protocol_unpack_snapshot(packet.payload.data(), packet.payload.size(), &snapshot) == 0)
+            {
+                std::snprintf(body, room,
+                              "snapshot ADC %u, %u mm, zone %s, alarm %s, closing %u mm/s, TTC %u ms, %s, mode %u"
+                              " | overruns %u, UART dropped %u, skipped %u",
+                              snapshot.value, snapshot.distance, zoneName(snapshot.zone), zoneName(snapshot.level),
+                              snapshot.closing_speed, snapshot.ttc_ms,
+                              (snapshot.flags & PROTOCOL_FLAG_ENABLED) ? "enabled" : "disabled",
+                              snapshot.flags >> PROTOCOL_FLAG_MODE_SHIFT, snapshot.adc_overruns,
+                              snapshot.uart_dropped, snapshot.skipped);
+                return line;
+            }
+            break;
+        case PROTOCOL_TYPE_STATUS:
+            if (protocol_unpack_status(packet.payload.data(), packet.payload.size(), &status) == 0)
+            {
+                std::snprintf(body, room,
+                              "status   ADC %u, %u mm, zone %s, alarm %s, closing %u mm/s, TTC %u ms"
+                              " | %u samples, %u overruns",
+                              status.value, status.distance, zoneName(status.zone), zoneName(status.level),
+                              status.closing_speed, status.ttc_ms, status.samples, status.overruns);
+                return line;
+            }
+            break;
+        case PROTOCOL_TYPE_LOG:
+        {
+            std::string text(packet.payload.begin(), packet.payload.end());
+            while (!text.empty() && (text.back() == '\n' || text.back() == '\r'))
+            {
+                text.pop_back();
+            }
+            return std::string(line, static_cast<size_t>(prefix)) + "log      " + text;
+        }
+        case PROTOCOL_TYPE_BATCH:
+            if (batch_unpack(packet.payload.data(), packet.payload.size(), &frame) == 0)
+            {
+                std::snprintf(body, room, "batch    %u samples from %u us, %u changes, %s, mode %u", frame.count,
+                              static_cast<unsigned>(frame.base), frame.changes,
+                              (frame.counters.flags & PROTOCOL_FLAG_ENABLED) ? "enabled" : "disabled",
+                              frame.counters.flags >> PROTOCOL_FLAG_MODE_SHIFT);
+                std::string text = line;
+                for (uint8_t i = 0; i < frame.count; i++)
+                {
+                    if (i == 0 || frame.states[i] != frame.states[i - 1])
+                    {
+                        uint8_t zone = frame.states[i] & 0x0F;
+                        uint8_t level = static_cast<uint8_t>(frame.states[i] >> BATCH_STATE_SHIFT);
+                        text += std::string(" | zone ") + zoneName(zone) + ", alarm " + zoneName(level) + ":";
+                    }
+                    text += " +" + std::to_string(frame.offsets[i]) + "=" + std::to_string(frame.values[i]);
+                }
+                return text + " | overruns " + std::to_string(frame.counters.adc_overruns) + ", UART dropped " +
+                       std::to_string(frame.counters.uart_dropped) + " (" + std::to_string(packet.payload.size()) +
+                       " bytes)";
+            }
+            break;
+        default: break;
+    }
+
+    std::snprintf(body, room, "type %u (%zu bytes) ", packet.header.type, packet.payload.size());
+    return std::string(line) + hex(packet.payload);
+}
+
+} // namespace telemetry
@@ -0,0 +1,99 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    TelemetryDecoder.hpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#ifndef TELEMETRY_DECODER_HPP
+#define TELEMETRY_DECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+#include "moduleBatch.h"
+#include "moduleProtocol.h"
+}
+
+/**
+ * @file TelemetryDecoder.hpp
+ * @brief Host decoder of the UART link packets.
+ *
+ * Wraps the stream decoder of moduleProtocol, which is the same code the firmware encodes with, and adds
+ * what only the host needs: packet lifetime beyond the next byte, loss detection from the sequence
+ * numbers and a text rendering of every known packet type.
+ */
+
+namespace telemetry
+{
+
+/**
+ * @brief One decoded packet.
+ */
+struct Packet
+{
+    protocol_header_t header;     ///< Type, sequence and timestamp.
+    std::vector<uint8_t> payload; ///< Payload bytes.
+};
+
+/**
+ * @brief Incremental decoder of a byte stream.
+ *
+ * Bytes can be fed in chunks of any size; the handler is called once for every valid packet.
+ */
+class Decoder
+{
+public:
+    using Handler = std::function<void(const Packet&)>;
+
+    /**
+     * @brief Create a decoder.
+     *
+     * @param handler Function called for every valid packet.
+     */
+    explicit Decoder(Handler handler);
+
+    /**
+     * @brief Feed received bytes.
+     *
+     * @param data   Received bytes.
+     * @param length Number of bytes.
+     */
+    void feed(const uint8_t* data, size_t length);
+
+    uint32_t frames() const { return state_.frames; }                  ///< Valid packets.
+    uint32_t crcErrors() const { return state_.crc_errors; }           ///< Packets with a bad CRC.
+    uint32_t framingErrors() const { return state_.framing_errors; }   ///< Packets with bad framing.
+    uint32_t lost() const { return lost_; }                            ///< Packets missing from the sequence.
+
+private:
+    protocol_decoder_t state_;
+    Handler handler_;
+    bool synced_ = false;
+    uint8_t nextSequence_ = 0;
+    uint32_t lost_ = 0;
+};
+
+/**
+ * @brief Render a packet as one line of text.
+ *
+ * @param packet Decoded packet.
+ * @return Timestamp, sequence and fields; unknown types and bad payload lengths are shown in hexadecimal.
+ */
+std::string describe(const Packet& packet);
+
+} // namespace telemetry
+
+#endif // TELEMETRY_DECODER_HPP
@@ -0,0 +1,284 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    adc_isr_bench.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+extern "C"
+{
+#include "moduleDistance.h"
+#include "moduleRing.h"
+#include "moduleSignal.h"
+#include "moduleTracker.h"
+#include "moduleZone.h"
+}
+
+#include "Bench.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @file adc_isr_bench.cpp
+ * @brief Host simulation of the legacy and minimal ADC interrupt handlers.
+ *
+ * Usage: `adc-isr-bench [conversions] [channels]`. The handlers themselves touch the ADC registers, so
+ * their work is rebuilt here from the same host library calls as moduleADC: the legacy handler runs the
+ * decimator, distance, zone, tracker and the push into the sample ring inside the interrupt; the minimal
+ * one only pushes the raw conversion, or every channel of a scan round, into the raw ring, and the
+ * PendSV consumer runs the chain. The cost inside the interrupt and the total per conversion are shown
+ * for the per-sample modes and for a scan of `channels` channels (1 and 5 by default).
+ *
+ * The rings publish their indexes behind a full memory barrier, measured and printed at the end: on an
+ * x86 host it costs tens of cycles and dominates the minimal handler, on the Cortex-M3 it is a DMB of a
+ * few. On target the legacy handler also pays the NVIC disable/enable writes, and the figures that count
+ * are the ones of `adc_isr_stats` and `adc_pipeline_stats` in the UART report; this run shows how the work
+ * is split between the two contexts.
+ */
+
+namespace
+{
+constexpr int repeats = 20;         ///< Passes over the input per figure.
+constexpr size_t consumerBatch = 8; ///< Entries popped at a time, `ADC_RAW_RING / 4`.
+constexpr size_t outputRing = 512;  ///< Filtered samples ring, `ADC_RING_SIZE`, drained as it fills.
+constexpr uint32_t rawRing = 32;    ///< Raw conversions ring, `ADC_RAW_RING`.
+
+/**
+ * @brief Firmware state touched by the chain, as the globals of moduleADC.
+ */
+struct Chain
+{
+    signal_decimator_t decimator;
+    tracker_t tracker;
+    uint8_t zone = ZONE_CLEAR;
+    uint8_t level = ZONE_CLEAR;
+    sample_ring_t ring;
+    std::vector<ring_sample_t> slots = std::vector<ring_sample_t>(outputRing);
+    ring_sample_t drained[outputRing];
+    uint16_t filtered[8];
+    uint16_t distance[8];
+    uint8_t zones[8];
+
+    void reset(uint8_t log2_ratio, uint32_t rate)
+    {
+        signal_decimator_init(&decimator, log2_ratio);
+        tracker_init(&tracker, rate, TRACKER_ALPHA, TRACKER_BETA);
+        ring_init(&ring, slots.data(), outputRing);
+        for (int i = 0; i < 8; i++)
+        {
+            filtered[i] = SIGNAL_RESULT_MASK;
+            zones[i] = ZONE_CLEAR;
+        }
+    }
+
+    /// continue_reverse(): distance, zone, tracker and the filtered sample ring.
+    void reverse(uint16_t value, uint32_t timestamp)
+    {
+        ring_sample_t sample;
+        uint16_t mm = distance_mm_from_counts(value);
+        uint8_t z = zone_classify(zone, mm);
+
+        tracker_update(&tracker, mm);
+        uint8_t urgency = tracker_urgency(&tracker);
+        zone = z;
+        level = (urgency > z) ? urgency : z;
+
+        sample.timestamp = timestamp;
+        sample.value = value;
+        sample.distance = mm;
+        sample.zone = zone;
+        sample.level = level;
+        if (ring_push(&ring, &sample) != 0)
+        {
+            ring_pop_batch(&ring, drained, outputRing); /**< The telemetry consumer, out of the measure. */
+            ring_push(&ring, &sample);
+        }
+    }
+
+    /// adc_process_sample().
+    void process(uint16_t value, uint32_t timestamp)
+    {
+        uint16_t out;
+        if (signal_decimate(&decimator, value, &out))
+        {
+            reverse(out, timestamp);
+        }
+    }
+
+    /// adc_scan_process().
+    void scan(uint8_t slot, uint8_t count, uint16_t value, uint32_t timestamp)
+    {
+        int32_t f = filtered[slot];
+        f += (static_cast<int32_t>(value) - f) >> 2;
+        filtered[slot] = static_cast<uint16_t>(f);
+        distance[slot] = distance_mm_from_counts(filtered[slot]);
+        zones[slot] = zone_classify(zones[slot], distance[slot]);
+        if (slot + 1 < count)
+        {
+            return;
+        }
+
+        uint16_t nearest = SIGNAL_RESULT_MASK;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            nearest = (filtered[i] < nearest) ? filtered[i] : nearest;
+        }
+        reverse(nearest, timestamp);
+    }
+};
+
+/**
+ * @brief Slowly approaching obstacle with some noise, in raw counts.
+ */
+std::vector<uint16_t> makeConversions(size_t count)
+{
+    std::vector<uint16_t> values(count);
+    uint32_t noise = 2024;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        noise = noise * 1103515245u + 12345u;
+        values[i] = static_cast<uint16_t>(3500 - (i * 3000) / count + ((noise >> 16) & 31));
+    }
+    return values;
+}
+
+void report(const char* mode, const char* handler, bench::Cost isr, bench::Cost total)
+{
+    std::printf("%-12s %-8s %10.2f %10.2f %12.2f %10.2f\n", mode, handler, isr.ns, isr.cycles, total.ns,
+                total.cycles);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t conversions = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    unsigned long channels = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 5;
+
+    if (conversions == 0 || channels == 0 || channels > 8)
+    {
+        std::fprintf(stderr, "conversions must be at least 1, channels 1 to 8\n");
+        return 2;
+    }
+
+    const uint8_t count = static_cast<uint8_t>(channels);
+    const size_t rounds = conversions / count;
+    std::vector<uint16_t> values = makeConversions(conversions);
+    ring_sample_t rawSlots[rawRing];
+    sample_ring_t raw;
+    Chain chain;
+
+    /// The minimal handler: one raw entry per conversion.
+    auto push = [&](size_t i, bool scan) {
+        ring_sample_t sample{};
+        sample.value = values[i];
+        sample.timestamp = static_cast<uint32_t>(i);
+        sample.zone = scan ? static_cast<uint8_t>(i % count) : 0;
+        ring_push(&raw, &sample);
+    };
+    /// adc_on_samples().
+    auto consume = [&](bool scan) {
+        ring_sample_t batch[consumerBatch];
+        size_t n;
+        while ((n = ring_pop_batch(&raw, batch, consumerBatch)) > 0)
+        {
+            for (size_t i = 0; i < n; i++)
+            {
+                if (scan)
+                {
+                    chain.scan(batch[i].zone, count, batch[i].value, batch[i].timestamp);
+                }
+                else
+                {
+                    chain.process(batch[i].value, batch[i].timestamp);
+                }
+            }
+        }
+    };
+    /// Handler alone: the ring is emptied without processing when full, once every `rawRing - 1` pushes.
+    auto handlerOnly = [&](bool scan) {
+        ring_init(&raw, rawSlots, rawRing);
+        for (size_t i = 0; i < conversions; i++)
+        {
+            if (ring_count(&raw) == rawRing - 1)
+            {
+                ring_init(&raw, rawSlots, rawRing);
+            }
+            push(i, scan);
+        }
+    };
+    /// Handler followed by PendSV, which tail-chains after every scan round or conversion on target.
+    auto handlerAndConsumer = [&](bool scan) {
+        ring_init(&raw, rawSlots, rawRing);
+        for (size_t i = 0; i < conversions; i++)
+        {
+            push(i, scan);
+            if (!scan || (i % count) == count - 1u)
+            {
+                consume(scan);
+            }
+        }
+    };
+
+    std::printf("%zu conversions, scan of %u channels%s\n\n", conversions, count,
+                BENCH_HAS_CYCLES ? "" : " (no cycle counter on this host)");
+    std::printf("mode         handler  ISR ns/conv  cycles  total ns/conv     cycles\n");
+
+    // Per-sample modes, 4:1 decimation as in the match-edge mode.
+    bench::Cost legacy = bench::measure(conversions, repeats, [&] {
+        chain.reset(2, 250);
+        for (size_t i = 0; i < conversions; i++)
+        {
+            chain.process(values[i], static_cast<uint32_t>(i));
+        }
+    });
+    report("per-sample", "legacy", legacy, legacy);
+
+    bench::Cost isr = bench::measure(conversions, repeats, [&] { handlerOnly(false); });
+    bench::Cost total = bench::measure(conversions, repeats, [&] {
+        chain.reset(2, 250);
+        handlerAndConsumer(false);
+    });
+    report("per-sample", "minimal", isr, total);
+
+    // Scan mode, whole rounds only.
+    bench::Cost scanLegacy = bench::measure(rounds * count, repeats, [&] {
+        chain.reset(0, 8000 / count);
+        for (size_t r = 0; r < rounds; r++)
+        {
+            for (uint8_t i = 0; i < count; i++)
+            {
+                chain.scan(i, count, values[r * count + i], static_cast<uint32_t>(r));
+            }
+        }
+    });
+    report("scan", "legacy", scanLegacy, scanLegacy);
+
+    isr = bench::measure(conversions, repeats, [&] { handlerOnly(true); });
+    total = bench::measure(conversions, repeats, [&] {
+        chain.reset(0, 8000 / count);
+        handlerAndConsumer(true);
+    });
+    report("scan", "minimal", isr, total);
+
+    bench::Cost barrier = bench::measure(conversions, repeats, [&] {
+        for (size_t i = 0; i < conversions; i++)
+        {
+            __sync_synchronize();
+        }
+    });
+    std::printf("\nmemory barrier %.2f ns, %.2f cycles alone: one per push, two per pop batch. On this host it is\n"
+                "a full fence, dearer still right after the slot stores; on the Cortex-M3 it is a DMB of a few\n"
+                "cycles, and the minimal handler is little more than the register read and the slot copy.\n",
+                barrier.ns, barrier.cycles);
+    return 0;
+}
@@ -0,0 +1,585 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    command_replay.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+extern "C"
+{
+#include "moduleBatch.h"
+#include "moduleBaud.h"
+#include "moduleCommand.h"
+#include "moduleFormat.h"
+#include "moduleZone.h"
+}
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @file command_replay.cpp
+ * @brief Replay byte scripts through the command parser and check the replies and the state they leave.
+ *
+ * Usage: `command-replay [script]`. Without a script the built-in one runs; `-` reads standard input. Every
+ * line of a script is one step:
+ *
+ * | Step            | Meaning                                                                  |
+ * |-----------------|--------------------------------------------------------------------------|
+ * | `> bytes`       | Received run, fed to the parser as one chunk; escapes `\n`, `\r`, `\t`,  |
+ * |                 | `\\` and `\xHH`.                                                         |
+ * | `+ count bytes` | The same run received `count` times, one chunk each.                     |
+ * | `< reply`       | Next reply line, without its newline.                                    |
+ * | `= key values`  | State: `zone`, `rate`, `telemetry`, `mode`, `baud`, `autobaud`, `batch`, |
+ * |                 | `lines`, `errors`, `checksum`.                                           |
+ * | `# text`        | Comment.                                                                 |
+ *
+ * Every reply must be expected before the next run is fed and by the end of the script. The chunks are fed
+ * the way `uart_on_command` feeds the receive ring. The replies are built by @ref command_reply, as on the
+ * target; the commands act on the host zone table and on a model of the rest of the firmware state, which
+ * mirrors the checks of `uart_execute`. `rate` answers with the rate asked for, since the rate the ADC
+ * really reaches depends on its clocking, and `status` only answers: its packet and reports are not modelled.
+ */
+
+namespace
+{
+constexpr uint32_t uart_pclk = 100000000; ///< UART0 peripheral clock, CCLK / 1 (moduleUART.c).
+constexpr uint32_t systick_ms = 50;       ///< `SYSTICK_TIME`.
+constexpr uint32_t max_period_ms = 60000; ///< `TELEMETRY_MAX_PERIOD_MS`.
+constexpr uint32_t mode_count = 4;        ///< `ADC_MODE_COUNT`.
+
+/**
+ * @brief Firmware state changed by the commands, other than the zone table.
+ */
+struct Target
+{
+    uint32_t rate = 0;         ///< Filtered sample rate asked for, 0 until a `rate` command.
+    uint32_t period_ticks = 2; ///< Snapshot period, in SysTick periods (`TELEMETRY_PERIOD_TICKS`).
+    uint32_t mode = 1;         ///< Acquisition mode (`ADC_DEFAULT_MODE`).
+    uint32_t baud = 9600;      ///< Line rate asked for (`COMMUNICATION_SPEED`).
+    uint32_t autobaud = 0;     ///< Auto-baud detections asked for.
+    uint32_t batch_size = 32;  ///< `TELEMETRY_BATCH_SIZE`.
+    uint32_t batch_age = 200;  ///< `TELEMETRY_BATCH_AGE_MS`.
+};
+
+const char* const builtin_script = R"(# Verbs, arguments and case
+> status\n
+< status: ok
+> ZONE 2 1000 1080\n
+< zone: ok
+= zone 2 1000 1080
+> zone 2 1200 1100\n
+< zone: rejected
+> zone 1 900 950\n
+< zone: rejected
+= zone 2 1000 1080
+> rate 250\n
+< rate: ok 250
+= rate 250
+> rate 0\n
+< rate: rejected
+> telemetry 500\n
+< telemetry: ok
+= telemetry 500
+> telemetry 60001\n
+< telemetry: rejected
+= telemetry 500
+> mode 3\n
+< mode: ok
+> mode 4\n
+< mode: rejected
+= mode 3
+> batch 16\n
+< batch: ok
+= batch 16 200
+> batch 65 10\n
+< batch: rejected
+= batch 16 200
+> baud 115200\n
+< Baud: 115200 (60 ppm)
+< baud: ok
+= baud 115200
+> baud 10\n
+< baud: rejected
+> baud\n
+< baud: ok
+= autobaud 1
+# Lines split across runs, several lines in one run, CR LF and blank lines
+> te
+> lemetry 2
+> 50\r\n
+< telemetry: ok
+= telemetry 250
+> \n\r\n \t \n
+> mode 1\nrate 100\n
+< mode: ok
+< rate: ok 100
+= mode 1
+# Unknown verbs and malformed arguments
+> reverse 1\n
+< ?: invalid
+> stat\n
+< ?: invalid
+> statuses\n
+< ?: invalid
+> rate 12a\n
+< ?: invalid
+> rate\n
+< ?: invalid
+> zone 1 2 3 4\n
+< ?: invalid
+> status 1\n
+< ?: invalid
+# Checksum
+> status*14\n
+< status: ok
+> zone 2 1000 1080*04\n
+< zone: ok
+> Zone 3 500 560*2b\n
+< zone: ok
+= zone 3 500 560
+> rate 100 *33 \n
+< rate: ok 100
+> status*15\n
+< ?: invalid
+> zone 2 1000 1100*04\n
+< ?: invalid
+= zone 2 1000 1080
+> status*1\n
+< ?: invalid
+> status*140\n
+< ?: invalid
+> status*\n
+< ?: invalid
+= checksum 4
+> status*zz\n
+< ?: invalid
+> status**14\n
+< ?: invalid
+= checksum 4
+# Overlong lines: verb past the longest name, argument past 32 bits, long run of blanks
+> statu
++ 300 s
+> \n
+< ?: invalid
+> rate 4294967295\n
+< rate: ok 4294967295
+> rate 4294967296\n
+< ?: invalid
+> rate 1
++ 40 0
+> \n
+< ?: invalid
+> rate
++ 1000 \x20
+> 100\n
+< rate: ok 100
+# Line noise: a control character drops the line in progress
+> zone 2 \x00status\n
+< status: ok
+> mode 2\x1b
+> mode 2\n
+< mode: ok
+= mode 2
+= lines 26
+= errors 17
+)";
+
+/**
+ * @brief Decode the escapes of a script run.
+ *
+ * @return false if an escape is malformed.
+ */
+bool unescape(const std::string& text, std::vector<uint8_t>& bytes)
+{
+    bytes.clear();
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if (text[i] != '\\')
+        {
+            bytes.push_back(static_cast<uint8_t>(text[i]));
+            continue;
+        }
+        if (++i == text.size())
+        {
+            return false;
+        }
+        switch (text[i])
+        {
+            case 'n': bytes.push_back('\n'); break;
+            case 'r': bytes.push_back('\r'); break;
+            case 't': bytes.push_back('\t'); break;
+            case '\\': bytes.push_back('\\'); break;
+            case 'x':
+            {
+                char hex[3] = {0, 0, 0};
+                char* end;
+                if (i + 2 >= text.size())
+                {
+                    return false;
+                }
+                hex[0] = text[i + 1];
+                hex[1] = text[i + 2];
+                bytes.push_back(static_cast<uint8_t>(std::strtoul(hex, &end, 16)));
+                if (end != hex + 2)
+                {
+                    return false;
+                }
+                i += 2;
+                break;
+            }
+            default: return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief The parser, the state it drives and the replies not checked yet.
+ */
+class Replay
+{
+public:
+    Replay()
+    {
+        command_parser_init(&parser);
+    }
+
+    /**
+     * @brief Feed one received run, as `uart_on_command` does with each contiguous run of the ring.
+     */
+    void feed(const std::vector<uint8_t>& bytes)
+    {
+        const uint8_t* data = bytes.data();
+        size_t count = bytes.size();
+        command_t command;
+
+        while (count > 0)
+        {
+            size_t used = command_feed(&parser, data, count, &command);
+            data += used;
+            count -= used;
+            if (command.id != COMMAND_NONE)
+            {
+                execute(command);
+            }
+        }
+    }
+
+    /**
+     * @brief Check a state value.
+     *
+     * @return Empty if it matches, otherwise the state found.
+     */
+    std::string check(const std::string& key, const std::vector<uint32_t>& values) const
+    {
+        std::vector<uint32_t> found;
+
+        if (key == "zone" && values.size() == 3 && values[0] < ZONE_COUNT)
+        {
+            found = {values[0], zone_table[values[0]].enter, zone_table[values[0]].exit};
+        }
+        else if (key == "rate")
+        {
+            found = {target.rate};
+        }
+        else if (key == "telemetry")
+        {
+            found = {target.period_ticks * systick_ms};
+        }
+        else if (key == "mode")
+        {
+            found = {target.mode};
+        }
+        else if (key == "baud")
+        {
+            found = {target.baud};
+        }
+        else if (key == "autobaud")
+        {
+            found = {target.autobaud};
+        }
+        else if (key == "batch")
+        {
+            found = {target.batch_size, target.batch_age};
+        }
+        else if (key == "lines")
+        {
+            found = {parser.lines};
+        }
+        else if (key == "errors")
+        {
+            found = {parser.errors};
+        }
+        else if (key == "checksum")
+        {
+            found = {parser.checksum_errors};
+        }
+        else
+        {
+            return "unknown";
+        }
+
+        if (found == values)
+        {
+            return "";
+        }
+        std::string text = key;
+        for (uint32_t value : found)
+        {
+            text += " " + std::to_string(value);
+        }
+        return text;
+    }
+
+    std::deque<std::string> replies; ///< Replies not checked yet, oldest first.
+
+private:
+    /**
+     * @brief Run a command on the model and queue its reply, as `uart_execute` does.
+     */
+    void execute(const command_t& command)
+    {
+        const uint32_t* argv = command.argv;
+        int result = -1;
+        uint32_t value = 0;
+        char buffer[COMMAND_REPLY_MAX];
+
+        switch (command.id)
+        {
+            case COMMAND_ZONE:
+                if (argv[0] < ZONE_COUNT && argv[1] <= UINT16_MAX && argv[2] <= UINT16_MAX)
+                {
+                    result = zone_set_band(static_cast<uint8_t>(argv[0]), static_cast<uint16_t>(argv[1]),
+                                           static_cast<uint16_t>(argv[2]));
+                }
+                break;
+            case COMMAND_RATE:
+                if (argv[0] > 0)
+                {
+                    target.rate = value = argv[0];
+                    result = 0;
+                }
+                break;
+            case COMMAND_TELEMETRY:
+                if (argv[0] <= max_period_ms)
+                {
+                    uint32_t ticks = (argv[0] + systick_ms / 2) / systick_ms;
+                    target.period_ticks = (argv[0] > 0 && ticks == 0) ? 1 : ticks;
+                    result = 0;
+                }
+                break;
+            case COMMAND_MODE:
+                if (argv[0] < mode_count)
+                {
+                    target.mode = argv[0];
+                    result = 0;
+                }
+                break;
+            case COMMAND_BAUD:
+                if (command.argc == 0)
+                {
+                    target.autobaud++;
+                    result = 0;
+                }
+                else
+                {
+                    result = set_baud(argv[0]);
+                }
+                break;
+            case COMMAND_STATUS: result = 0; break;
+            case COMMAND_BATCH:
+            {
+                uint32_t age = (command.argc > 1) ? argv[1] : target.batch_age;
+                if (argv[0] > 0 && argv[0] <= BATCH_MAX_SAMPLES && age <= max_period_ms)
+                {
+                    target.batch_size = argv[0];
+                    target.batch_age = age;
+                    result = 0;
+                }
+                break;
+            }
+            default: break;
+        }
+
+        size_t length = command_reply(&command, result, value, buffer);
+        replies.emplace_back(buffer, length - 1);
+    }
+
+    /**
+     * @brief Check a line rate and announce it, as `uart_set_baud` does.
+     */
+    int set_baud(uint32_t baud)
+    {
+        baud_divider_t divider;
+        char buffer[40];
+        char* p = buffer;
+
+        if (baud_divider(uart_pclk, baud, &divider) != 0)
+        {
+            return -1;
+        }
+        p += format_text(p, "Baud: ");
+        p += format_unsigned(p, baud);
+        p += format_text(p, " (");
+        p += format_signed(p, divider.error_ppm);
+        p += format_text(p, " ppm)");
+        replies.emplace_back(buffer, static_cast<size_t>(p - buffer));
+        target.baud = baud;
+        return 0;
+    }
+
+    command_parser_t parser;
+    Target target;
+};
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string script;
+
+    if (argc > 2)
+    {
+        std::fprintf(stderr, "usage: %s [script]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2)
+    {
+        FILE* input = (std::strcmp(argv[1], "-") == 0) ? stdin : std::fopen(argv[1], "r");
+        char chunk[256];
+        size_t count;
+
+        if (input == nullptr)
+        {
+            std::perror(argv[1]);
+            return 1;
+        }
+        while ((count = std::fread(chunk, 1, sizeof(chunk), input)) > 0)
+        {
+            script.append(chunk, count);
+        }
+    }
+    else
+    {
+        script = builtin_script;
+    }
+
+    Replay replay;
+    std::vector<uint8_t> bytes;
+    unsigned steps = 0;
+    unsigned failures = 0;
+    unsigned number = 0;
+    size_t start = 0;
+
+    auto fail = [&](const char* what, const std::string& detail) {
+        std::printf("line %u: %s%s\n", number, what, detail.c_str());
+        failures++;
+    };
+    auto unchecked = [&]() {
+        for (; !replay.replies.empty(); replay.replies.pop_front())
+        {
+            fail("unexpected reply: ", replay.replies.front());
+        }
+    };
+
+    while (start < script.size())
+    {
+        size_t end = script.find('\n', start);
+        std::string line = script.substr(start, (end == std::string::npos) ? std::string::npos : end - start);
+        start = (end == std::string::npos) ? script.size() : end + 1;
+        number++;
+
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        if (line.size() < 2 || line[1] != ' ')
+        {
+            fail("malformed step: ", line);
+            continue;
+        }
+
+        std::string text = line.substr(2);
+        steps++;
+        switch (line[0])
+        {
+            case '>':
+            case '+':
+            {
+                unsigned long repeat = 1;
+                if (line[0] == '+')
+                {
+                    char* rest;
+                    repeat = std::strtoul(text.c_str(), &rest, 10);
+                    text = (*rest == ' ') ? std::string(rest + 1) : std::string();
+                }
+                if (!unescape(text, bytes) || bytes.empty() || repeat == 0)
+                {
+                    fail("malformed run: ", line);
+                    break;
+                }
+                unchecked();
+                for (unsigned long i = 0; i < repeat; i++)
+                {
+                    replay.feed(bytes);
+                }
+                break;
+            }
+            case '<':
+                if (replay.replies.empty())
+                {
+                    fail("no reply, expected: ", text);
+                }
+                else
+                {
+                    if (replay.replies.front() != text)
+                    {
+                        fail("reply ", "'" + replay.replies.front() + "', expected '" + text + "'");
+                    }
+                    replay.replies.pop_front();
+                }
+                break;
+            case '=':
+            {
+                std::vector<uint32_t> values;
+                size_t space = text.find(' ');
+                std::string key = text.substr(0, space);
+                char* rest = (space == std::string::npos) ? nullptr : &text[space];
+
+                while (rest != nullptr && *rest != '\0')
+                {
+                    char* next;
+                    values.push_back(static_cast<uint32_t>(std::strtoul(rest, &next, 10)));
+                    rest = (next != rest) ? next : nullptr;
+                }
+                if (rest == nullptr && space != std::string::npos)
+                {
+                    fail("malformed state: ", line);
+                    break;
+                }
+                std::string found = replay.check(key, values);
+                if (!found.empty())
+                {
+                    fail("state ", found + ", expected " + text);
+                }
+                break;
+            }
+            default: fail("malformed step: ", line); break;
+        }
+    }
+    unchecked();
+
+    std::printf("%u steps, %u failures\n", steps, failures);
+    return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    format_bench.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+extern "C"
+{
+#include "moduleFormat.h"
+}
+
+#include "Bench.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/**
+ * @file format_bench.cpp
+ * @brief Time of the moduleFormat conversions against `snprintf` over the same inputs.
+ *
+ * Usage: `format-bench [values]`. `values` random 32-bit values (100000 by default), with the
+ * INT32_MIN/UINT32_MAX edges, are converted by every function and by the `snprintf` format that gives the
+ * same text, and both results are compared; a whole ADC report line is also built both ways. The
+ * host `snprintf` is glibc's, the firmware's was newlib's, so only the ratio carries over.
+ *
+ * The flash side of the comparison needs the cross toolchain: build the firmware and run
+ * `arm-none-eabi-size` on it, before and after, which this host tool cannot do.
+ */
+
+namespace
+{
+constexpr int repeats = 10; ///< Passes over the values per figure.
+
+/// One conversion done both ways.
+struct Case
+{
+    const char* name;
+    size_t (*format)(char* out, uint32_t value);
+    int (*reference)(char* out, size_t room, uint32_t value);
+};
+
+const Case cases[] = {
+    {"unsigned", [](char* out, uint32_t v) { return format_unsigned(out, v); },
+     [](char* out, size_t room, uint32_t v) { return std::snprintf(out, room, "%" PRIu32, v); }},
+    {"signed", [](char* out, uint32_t v) { return format_signed(out, static_cast<int32_t>(v)); },
+     [](char* out, size_t room, uint32_t v) {
+         return std::snprintf(out, room, "%" PRId32, static_cast<int32_t>(v));
+     }},
+    {"hex 4", [](char* out, uint32_t v) { return format_hex(out, v, 4); },
+     [](char* out, size_t room, uint32_t v) { return std::snprintf(out, room, "%04" PRIX32, v); }},
+    {"fixed 3", [](char* out, uint32_t v) { return format_fixed(out, static_cast<int32_t>(v), 3); },
+     [](char* out, size_t room, uint32_t v) {
+         int32_t s = static_cast<int32_t>(v);
+         uint32_t m = (s < 0) ? 0u - v : v;
+         return std::snprintf(out, room, "%s%" PRIu32 ".%03" PRIu32, (s < 0) ? "-" : "", m / 1000, m % 1000);
+     }},
+};
+
+/// An ADC report line, built as the UART text reports are.
+size_t adcLine(char* p, uint32_t value, uint32_t distance, uint32_t timestamp, uint32_t samples, uint32_t overruns)
+{
+    char* start = p;
+    p += format_text(p, "ADC: ");
+    p += format_unsigned(p, value);
+    p += format_text(p, " (");
+    p += format_fixed(p, static_cast<int32_t>(distance), 3);
+    p += format_text(p, " m) at ");
+    p += format_unsigned(p, timestamp);
+    p += format_text(p, " us | ");
+    p += format_unsigned(p, samples);
+    p += format_text(p, " samples, ");
+    p += format_unsigned(p, overruns);
+    p += format_text(p, " overruns\n");
+    return static_cast<size_t>(p - start);
+}
+
+/// The same line with `snprintf`, as the sprintf version built it.
+size_t adcLinePrintf(char* p, size_t room, uint32_t value, uint32_t distance, uint32_t timestamp,
+                     uint32_t samples, uint32_t overruns)
+{
+    return static_cast<size_t>(std::snprintf(p, room,
+                                             "ADC: %" PRIu32 " (%" PRIu32 ".%03" PRIu32 " m) at %" PRIu32
+                                             " us | %" PRIu32 " samples, %" PRIu32 " overruns\n",
+                                             value, distance / 1000, distance % 1000, timestamp, samples,
+                                             overruns));
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t count = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    std::vector<uint32_t> values(count + 4);
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+    char out[64];
+    char reference[64];
+    size_t sink = 0; /**< Keeps the results in use. */
+    bool match = true;
+
+    if (count == 0)
+    {
+        std::fprintf(stderr, "values must be at least 1\n");
+        return 2;
+    }
+    values[0] = 0;
+    values[1] = UINT32_MAX;
+    values[2] = 0x80000000u; /**< INT32_MIN. */
+    values[3] = 0x7FFFFFFFu;
+    for (size_t i = 4; i < values.size(); i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        values[i] = static_cast<uint32_t>(state >> (state & 31)); /**< Every length of number. */
+    }
+
+    std::printf("%zu values%s\n\n", values.size(), BENCH_HAS_CYCLES ? "" : " (no cycle counter on this host)");
+    std::printf("conversion   format ns  cycles  snprintf ns  cycles  speed-up\n");
+    for (const Case& c : cases)
+    {
+        for (uint32_t v : values)
+        {
+            size_t length = c.format(out, v);
+            int expected = c.reference(reference, sizeof(reference), v);
+            match = match && length == static_cast<size_t>(expected) && std::memcmp(out, reference, length) == 0;
+        }
+
+        bench::Cost mine = bench::measure(values.size(), repeats, [&] {
+            for (uint32_t v : values)
+            {
+                sink += c.format(out, v);
+            }
+        });
+        bench::Cost theirs = bench::measure(values.size(), repeats, [&] {
+            for (uint32_t v : values)
+            {
+                sink += static_cast<size_t>(c.reference(out, sizeof(out), v));
+            }
+        });
+        std::printf("%-10s %11.1f %7.1f %12.1f %7.1f %8.1fx\n", c.name, mine.ns, mine.cycles, theirs.ns,
+                    theirs.cycles, theirs.ns / mine.ns);
+    }
+
+    char line[128];
+    char lineRef[128];
+    for (size_t i = 0; i + 4 < values.size(); i++)
+    {
+        size_t length = adcLine(line, values[i] & 0xFFF, values[i + 1] & 0xFFFF, values[i + 2], values[i + 3] & 0xFF,
+                                values[i + 4] & 0xFFFF);
+        size_t expected = adcLinePrintf(lineRef, sizeof(lineRef), values[i] & 0xFFF, values[i + 1] & 0xFFFF,
+                                        values[i + 2], values[i + 3] & 0xFF, values[i + 4] & 0xFFFF);
+        match = match && length == expected && std::memcmp(line, lineRef, length) == 0;
+    }
+    bench::Cost mine = bench::measure(values.size() - 4, repeats, [&] {
+        for (size_t i = 0; i + 4 < values.size(); i++)
+        {
+            sink += adcLine(line, values[i] & 0xFFF, values[i + 1] & 0xFFFF, values[i + 2], values[i + 3] & 0xFF,
+                            values[i + 4] & 0xFFFF);
+        }
+    });
+    bench::Cost theirs = bench::measure(values.size() - 4, repeats, [&] {
+        for (size_t i = 0; i + 4 < values.size(); i++)
+        {
+            sink += adcLinePrintf(line, sizeof(line), values[i] & 0xFFF, values[i + 1] & 0xFFFF, values[i + 2],
+                                  values[i + 3] & 0xFF, values[i + 4] & 0xFFFF);
+        }
+    });
+    std::printf("%-10s %11.1f %7.1f %12.1f %7.1f %8.1fx\n", "ADC line", mine.ns, mine.cycles, theirs.ns,
+                theirs.cycles, theirs.ns / mine.ns);
+
+    std::printf("\noutputs %s (%zu characters written)\n", match ? "identical" : "DIFFER", sink);
+    return match ? 0 : 1;
+}
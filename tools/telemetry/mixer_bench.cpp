@@ -0,0 +1,94 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    mixer_bench.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+extern "C"
+{
+#include "moduleMixer.h"
+}
+
+#include "Bench.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @file mixer_bench.cpp
+ * @brief Cost per block of the tone mixer, for one to several voices.
+ *
+ * Usage: `mixer-bench [blocks] [voices]`. The mixer is set up as moduleDAC does it (64 point sine,
+ * 10-bit codes around 512, 25.6 kHz, 64 sample blocks in DACR layout) and every voice as moduleBuzzer
+ * loads a scanned sensor: half gain, (8 + i) / 8 times a 400 Hz tone, beeping at the cadence of a distance
+ * that grows with the voice. `blocks` blocks (10000 by default) are rendered with 1 to `voices` voices
+ * (`MIXER_VOICES` by default); the cost per block is shown against the 2.5 ms a block lasts on the DAC.
+ */
+
+namespace
+{
+constexpr int repeats = 5;                          ///< Passes over the blocks per figure.
+constexpr uint8_t pointsLog2 = 6;                   ///< `DAC_WAVE_LOG2`.
+constexpr uint16_t midscale = 512;                  ///< `DAC_MIDSCALE`.
+constexpr uint32_t sampleRate = 25600;              ///< `DAC_UPDATE_RATE`.
+constexpr size_t block = 64;                        ///< `DAC_MIX_BLOCK`.
+constexpr uint8_t valueShift = 6;                   ///< `DAC_VALUE_SHIFT`.
+constexpr uint16_t voiceGain = MIXER_GAIN_FULL / 2; ///< `BUZZER_VOICE_GAIN`.
+constexpr uint32_t baseTone = 400;                  ///< Caution tone of moduleBuzzer, in hertz.
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t blocks = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    unsigned long voices = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : MIXER_VOICES;
+
+    if (blocks == 0 || voices == 0 || voices > MIXER_VOICES)
+    {
+        std::fprintf(stderr, "blocks must be at least 1, voices 1 to %d\n", MIXER_VOICES);
+        return 2;
+    }
+
+    std::vector<uint16_t> table(size_t(1) << pointsLog2);
+    for (size_t i = 0; i < table.size(); i++)
+    {
+        double angle = 2 * M_PI * i / table.size();
+        table[i] = static_cast<uint16_t>(std::lround(midscale + (midscale - 1) * std::sin(angle)));
+    }
+
+    const double budget_ns = 1e9 * block / sampleRate;
+    std::vector<uint32_t> out(block);
+    mixer_t mixer;
+
+    std::printf("%zu blocks of %zu samples, %.0f us of output per block%s\n\n", blocks, block, budget_ns / 1e3,
+                BENCH_HAS_CYCLES ? "" : " (no cycle counter on this host)");
+    std::printf("voices  ns/block  cycles/block  ns/sample  budget %%  clipped\n");
+    for (uint8_t n = 1; n <= voices; n++)
+    {
+        mixer_init(&mixer, table.data(), pointsLog2, midscale, sampleRate);
+        for (uint8_t i = 0; i < n; i++)
+        {
+            mixer_set_tone(&mixer, i, baseTone * (8 + i) / 8, voiceGain);
+            mixer_set_distance(&mixer, i, static_cast<uint16_t>(300 + 200 * i));
+        }
+
+        bench::Cost cost = bench::measure(blocks, repeats, [&] {
+            for (size_t b = 0; b < blocks; b++)
+            {
+                mixer_render(&mixer, out.data(), block, valueShift);
+            }
+        });
+        std::printf("%6u  %8.1f  %12.1f  %9.2f  %8.4f  %7u\n", n, cost.ns, cost.cycles, cost.ns / block,
+                    100 * cost.ns / budget_ns, mixer.clipped);
+    }
+    return 0;
+}
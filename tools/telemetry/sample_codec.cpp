@@ -0,0 +1,126 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    sample_codec.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+extern "C"
+{
+#include "moduleCodec.h"
+}
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/**
+ * @file sample_codec.cpp
+ * @brief Compression ratio and throughput of the sample codec on a recorded trace.
+ *
+ * Usage: `sample-codec [trace] [block]`. The trace holds one sample per line, as decimal text (standard
+ * input by default); `block` is the number of samples per block, 32 (`TELEMETRY_BATCH_SIZE`) by default.
+ * The trace is encoded block by block, decoded back one byte at a time with the streaming decoder and
+ * compared with the original. The encoded size is reported against the raw 16-bit values, the 12-bit
+ * values packed, and decimal text with a newline per sample.
+ */
+
+namespace
+{
+constexpr int repeats = 20; ///< Passes over the trace for the throughput figures.
+
+double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    FILE* input = (argc > 1) ? std::fopen(argv[1], "r") : stdin;
+    size_t block = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 32;
+    std::vector<uint16_t> trace;
+    size_t text_bytes = 0;
+    unsigned long value;
+
+    if (input == nullptr)
+    {
+        std::perror(argv[1]);
+        return 1;
+    }
+    if (block == 0 || block > 0xFFFF)
+    {
+        std::fprintf(stderr, "block must be 1 to 65535 samples\n");
+        return 2;
+    }
+    while (std::fscanf(input, "%lu", &value) == 1)
+    {
+        trace.push_back(static_cast<uint16_t>(value));
+        text_bytes += static_cast<size_t>(std::snprintf(nullptr, 0, "%lu\n", value));
+    }
+    if (trace.empty())
+    {
+        std::fprintf(stderr, "no samples\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> encoded(CODEC_BLOCK_MAX(block) * (trace.size() / block + 1));
+    size_t length = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < repeats; pass++)
+    {
+        length = 0;
+        for (size_t i = 0; i < trace.size(); i += block)
+        {
+            size_t count = std::min(block, trace.size() - i);
+            length += codec_encode_block(&trace[i], count, &encoded[length]);
+        }
+    }
+    double encode_time = seconds(start) / repeats;
+
+    std::vector<uint16_t> decoded(trace.size());
+    codec_decoder_t decoder;
+    size_t produced = 0;
+    start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < repeats; pass++)
+    {
+        codec_decoder_init(&decoder);
+        produced = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            uint16_t samples[2];
+            size_t count = codec_decoder_feed(&decoder, encoded[i], samples);
+            for (size_t k = 0; k < count && produced < decoded.size(); k++)
+            {
+                decoded[produced++] = samples[k];
+            }
+        }
+    }
+    double decode_time = seconds(start) / repeats;
+
+    bool match = produced == trace.size() && decoder.errors == 0 &&
+                 std::memcmp(decoded.data(), trace.data(), trace.size() * sizeof(uint16_t)) == 0;
+    size_t raw = trace.size() * 2;
+    size_t packed = (trace.size() * 12 + 7) / 8;
+
+    std::printf("samples     %zu in blocks of %zu\n", trace.size(), block);
+    std::printf("encoded     %zu bytes, %.3f bytes/sample\n", length, double(length) / trace.size());
+    std::printf("vs 16-bit   %zu bytes, ratio %.2f\n", raw, double(raw) / length);
+    std::printf("vs 12-bit   %zu bytes, ratio %.2f\n", packed, double(packed) / length);
+    std::printf("vs text     %zu bytes, ratio %.2f\n", text_bytes, double(text_bytes) / length);
+    std::printf("encode      %.1f Msamples/s\n", trace.size() / encode_time / 1e6);
+    std::printf("decode      %.1f Msamples/s, %.1f MB/s of encoded stream\n", trace.size() / decode_time / 1e6,
+                length / decode_time / 1e6);
+    std::printf("round trip  %s\n", match ? "identical" : "MISMATCH");
+    return match ? 0 : 1;
+}
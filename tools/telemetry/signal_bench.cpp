@@ -0,0 +1,124 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    signal_bench.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+extern "C"
+{
+#include "moduleSignal.h"
+}
+
+#include "Bench.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * @file signal_bench.cpp
+ * @brief Cost per input sample of the ADC block filter stage.
+ *
+ * Usage: `signal-bench [block] [blocks]`. A noisy synthetic signal is packed as ADGDR words, `blocks`
+ * blocks of `block` words (128, `ADC_BLOCK_SIZE`, and 1024 by default), and run through the same calls as
+ * `adc_process_block`: unpack, then the block decimator, for every ratio up to 64:1. The single sample
+ * decimator, used by the timer driven modes, is timed over the same input and must give the same output.
+ */
+
+namespace
+{
+constexpr int repeats = 50; ///< Passes over the buffer per figure.
+
+/**
+ * @brief Noisy ramp as raw ADC words: result in bits 15:4, DONE on top.
+ */
+std::vector<uint32_t> makeWords(size_t count)
+{
+    std::vector<uint32_t> words(count);
+    uint32_t noise = 12345;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        noise = noise * 1103515245u + 12345u;
+        uint32_t value = (2048 + (i % 1024) + ((noise >> 16) & 63)) & SIGNAL_RESULT_MASK;
+        words[i] = (1u << 31) | (value << SIGNAL_RESULT_SHIFT);
+    }
+    return words;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    size_t block = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 128;
+    size_t blocks = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 1024;
+
+    if (block == 0 || blocks == 0)
+    {
+        std::fprintf(stderr, "block and blocks must be at least 1\n");
+        return 2;
+    }
+
+    const size_t total = block * blocks;
+    std::vector<uint32_t> words = makeWords(total);
+    std::vector<uint16_t> samples(block);
+    std::vector<uint16_t> reference(total);
+    std::vector<uint16_t> output(total);
+    size_t produced = 0;
+    bool match = true;
+
+    bench::Cost unpack = bench::measure(total, repeats, [&] {
+        for (size_t b = 0; b < blocks; b++)
+        {
+            signal_unpack_block(&words[b * block], samples.data(), block);
+        }
+    });
+    std::printf("%zu samples in blocks of %zu%s\n\n", total, block,
+                BENCH_HAS_CYCLES ? "" : " (no cycle counter on this host)");
+    std::printf("stage           ratio   ns/sample  cycles/sample\n");
+    std::printf("unpack              -   %9.2f  %13.2f\n", unpack.ns, unpack.cycles);
+
+    for (uint8_t log2 = 0; log2 <= 6; log2++)
+    {
+        signal_decimator_t dec;
+
+        bench::Cost blockCost = bench::measure(total, repeats, [&] {
+            signal_decimator_init(&dec, log2);
+            produced = 0;
+            for (size_t b = 0; b < blocks; b++)
+            {
+                signal_unpack_block(&words[b * block], samples.data(), block);
+                produced += signal_decimate_block(&dec, samples.data(), block, &output[produced]);
+            }
+        });
+
+        size_t expected = 0;
+        bench::Cost sampleCost = bench::measure(total, repeats, [&] {
+            signal_decimator_init(&dec, log2);
+            expected = 0;
+            for (size_t i = 0; i < total; i++)
+            {
+                expected += static_cast<size_t>(signal_decimate(&dec, SIGNAL_RESULT(words[i]), &reference[expected]));
+            }
+        });
+
+        for (size_t i = 0; i < produced; i++)
+        {
+            match = match && output[i] == reference[i];
+        }
+        match = match && produced == expected;
+
+        std::printf("unpack + block  %5u   %9.2f  %13.2f\n", 1u << log2, blockCost.ns, blockCost.cycles);
+        std::printf("per sample      %5u   %9.2f  %13.2f\n", 1u << log2, sampleCost.ns, sampleCost.cycles);
+    }
+
+    std::printf("\nblock and per sample outputs %s\n", match ? "identical" : "DIFFER");
+    return match ? 0 : 1;
+}
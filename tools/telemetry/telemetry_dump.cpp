@@ -0,0 +1,52 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    telemetry_dump.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+#include "TelemetryDecoder.hpp"
+
+#include <cstdio>
+
+/**
+ * @file telemetry_dump.cpp
+ * @brief Print every packet received on the UART link.
+ *
+ * Usage: `telemetry-dump [capture-or-device]`, standard input by default. A serial port must be set to raw
+ * mode first, e.g. `stty -F /dev/ttyUSB0 9600 raw -echo`. The decoder counters are printed at the end.
+ */
+
+int main(int argc, char** argv)
+{
+    FILE* input = (argc > 1) ? std::fopen(argv[1], "rb") : stdin;
+    uint8_t chunk[256];
+    size_t count;
+
+    if (input == nullptr)
+    {
+        std::perror(argv[1]);
+        return 1;
+    }
+
+    telemetry::Decoder decoder([](const telemetry::Packet& packet) {
+        std::printf("%s\n", telemetry::describe(packet).c_str());
+        std::fflush(stdout);
+    });
+
+    while ((count = std::fread(chunk, 1, sizeof(chunk), input)) > 0)
+    {
+        decoder.feed(chunk, count);
+    }
+
+    std::fprintf(stderr, "%u packets, %u lost, %u CRC errors, %u framing errors\n", decoder.frames(),
+                 decoder.lost(), decoder.crcErrors(), decoder.framingErrors());
+    return 0;
+}
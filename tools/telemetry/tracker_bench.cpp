@@ -0,0 +1,125 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    tracker_bench.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+extern "C"
+{
+#include "moduleDistance.h"
+#include "moduleTracker.h"
+#include "moduleZone.h"
+}
+
+#include "Bench.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/**
+ * @file tracker_bench.cpp
+ * @brief Closing speed and time to collision estimates of a recorded trace, and their cost per sample.
+ *
+ * Usage: `tracker-bench [trace|-] [every-ms] [mm]`. The trace holds one `timestamp value` pair per line,
+ * the timestamp in microseconds and the value in filtered ADC counts (standard input by default): the base
+ * plus offset and the value of every sample of the batch frames. With `mm` the values are already
+ * distances in millimetres. The tracker is given the mean rate of the trace as its sample rate, as
+ * `adc_output_rate` gives it on target.
+ *
+ * Every `every-ms` milliseconds of trace (100 by default) one line shows the measured and estimated
+ * distance, the closing speed, the time to collision and the alarm level it demands, so the estimates can
+ * be checked against the recording; the cost of `tracker_update` per sample closes the report.
+ */
+
+namespace
+{
+constexpr int repeats = 20; ///< Passes over the trace for the timing figure.
+
+/**
+ * @brief One line of the trace.
+ */
+struct Sample
+{
+    uint32_t timestamp; ///< Microseconds.
+    uint16_t distance;  ///< Millimetres.
+    uint16_t value;     ///< Value as read from the trace.
+};
+} // namespace
+
+int main(int argc, char** argv)
+{
+    FILE* input = (argc > 1 && std::strcmp(argv[1], "-") != 0) ? std::fopen(argv[1], "r") : stdin;
+    unsigned long every_ms = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : 100;
+    bool millimetres = argc > 3 && std::strcmp(argv[3], "mm") == 0;
+    std::vector<Sample> trace;
+    unsigned long timestamp;
+    unsigned long value;
+
+    if (input == nullptr)
+    {
+        std::perror(argv[1]);
+        return 1;
+    }
+    while (std::fscanf(input, "%lu %lu", &timestamp, &value) == 2)
+    {
+        uint16_t v = static_cast<uint16_t>(value);
+        trace.push_back({static_cast<uint32_t>(timestamp), millimetres ? v : distance_mm_from_counts(v), v});
+    }
+    if (trace.size() < 2)
+    {
+        std::fprintf(stderr, "at least two samples are needed\n");
+        return 1;
+    }
+
+    uint32_t span = trace.back().timestamp - trace.front().timestamp;
+    uint32_t rate = (span > 0) ? static_cast<uint32_t>((uint64_t(trace.size() - 1) * 1000000 + span / 2) / span) : 1;
+    tracker_t tracker;
+
+    std::printf("%zu samples over %.3f s, %u Hz\n\n", trace.size(), span / 1e6, rate);
+    std::printf("    time s   value  measured mm  estimated mm  closing mm/s  TTC ms  alarm\n");
+    tracker_init(&tracker, rate, TRACKER_ALPHA, TRACKER_BETA);
+    uint32_t next = trace.front().timestamp;
+    for (const Sample& s : trace)
+    {
+        tracker_update(&tracker, s.distance);
+        if (static_cast<int32_t>(s.timestamp - next) < 0)
+        {
+            continue;
+        }
+        next = s.timestamp + static_cast<uint32_t>(every_ms * 1000);
+
+        char ttc[8] = "-";
+        if (tracker.ttc_ms != TRACKER_TTC_NONE)
+        {
+            std::snprintf(ttc, sizeof(ttc), "%u", tracker.ttc_ms);
+        }
+        std::printf("%10.3f  %6u  %11u  %12d  %12u  %6s  %s\n", (s.timestamp - trace.front().timestamp) / 1e6,
+                    s.value, s.distance, tracker.position >> TRACKER_Q, tracker.closing_speed, ttc,
+                    zone_name(tracker_urgency(&tracker)));
+    }
+
+    bench::Cost cost = bench::measure(trace.size(), repeats, [&] {
+        tracker_init(&tracker, rate, TRACKER_ALPHA, TRACKER_BETA);
+        for (const Sample& s : trace)
+        {
+            tracker_update(&tracker, s.distance);
+        }
+    });
+    std::printf("\ntracker_update  %.2f ns/sample", cost.ns);
+    if (BENCH_HAS_CYCLES)
+    {
+        std::printf(", %.2f cycles/sample", cost.cycles);
+    }
+    std::printf("\n");
+    return 0;
+}
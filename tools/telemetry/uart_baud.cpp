@@ -0,0 +1,114 @@
+/****************************************************************************
+ * Project: Reverse Parking Sensor System
+ * File:    uart_baud.cpp
+ * Author:  Juan Ignacio Sassi
+ * Date:    17/10/2026
+ * Description:
+ *    This project implements a proximity sensor to assist when reversing a car. The system is developed 
+ *    on the LPC1769 (Rev C) board and uses multiple modules and peripherals to ensure efficient control 
+ *    and monitoring, providing real-time interaction with the user.
+ *
+ * This file is part of a project developed for the course Digital Electronics III at FCEFYN, 
+ * National University of Córdoba (UNC). 
+ * All rights reserved.
+ ****************************************************************************/
+extern "C"
+{
+#include "moduleBaud.h"
+}
+
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+/**
+ * @file uart_baud.cpp
+ * @brief Move the UART link to another rate through the firmware auto-baud detection.
+ *
+ * Usage: `uart-baud <device> <current> <new>`. A break at the current rate asks the firmware for auto-baud;
+ * once it holds its transmitter, an 'A' at the new rate is measured and snapped to the nearest standard
+ * rate. The port is left at the new rate, ready for `telemetry-dump`.
+ */
+
+namespace
+{
+/**
+ * @brief termios constant of a standard rate, B0 if there is none.
+ */
+speed_t termios_speed(uint32_t baud)
+{
+    switch (baud)
+    {
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default: return B0;
+    }
+}
+
+/**
+ * @brief Put the port in raw 8N1 mode at a rate, after the pending output has left.
+ */
+bool set_speed(int fd, speed_t speed)
+{
+    termios tty{};
+
+    if (tcgetattr(fd, &tty) != 0)
+    {
+        return false;
+    }
+    cfmakeraw(&tty);
+    tty.c_cflag |= CLOCAL | CREAD;
+    cfsetispeed(&tty, speed);
+    cfsetospeed(&tty, speed);
+    return tcsetattr(fd, TCSADRAIN, &tty) == 0;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 4)
+    {
+        std::fprintf(stderr, "usage: %s <device> <current> <new>\n", argv[0]);
+        return 2;
+    }
+
+    const uint32_t current = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+    const uint32_t target = static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10));
+    if (!baud_is_standard(current) || !baud_is_standard(target))
+    {
+        std::fprintf(stderr, "rates must be standard (9600 to 921600 bps)\n");
+        return 2;
+    }
+
+    int fd = open(argv[1], O_RDWR | O_NOCTTY);
+    if (fd < 0)
+    {
+        std::perror(argv[1]);
+        return 1;
+    }
+
+    const char autobaud = 'A';
+    bool ok = set_speed(fd, termios_speed(current));
+    ok = ok && tcsendbreak(fd, 0) == 0;
+    usleep(150000); /* The firmware arms auto-baud on its next SysTick period once its transmitter is idle. */
+    ok = ok && set_speed(fd, termios_speed(target));
+    ok = ok && tcflush(fd, TCIFLUSH) == 0;
+    ok = ok && write(fd, &autobaud, 1) == 1;
+    ok = ok && tcdrain(fd) == 0;
+    close(fd);
+
+    if (!ok)
+    {
+        std::perror(argv[1]);
+        return 1;
+    }
+    return 0;
+}